@@ -0,0 +1,232 @@
+#include "pico/stdlib.h"
+#include <algorithm>
+#include "Charset.hpp"
+
+namespace lcd4pico
+{
+    namespace charset
+    {
+        static constexpr uint8_t NO_CODE = 0xFF; // in the ASCII tables, no ROM maps ASCII to 0xFF
+
+        // sorted by code point, from the character tables of the HD44780U datasheet
+        inline constexpr Range A00_RANGES[] = {
+            {0x20, 0x5B, 0x20},     // ASCII up to '['
+            {0x5D, 0x7D, 0x5D},     // ASCII from ']' to '}'
+            {0xA2, 0xA2, 0xEC},     // ¢
+            {0xA3, 0xA3, 0xED},     // £
+            {0xA5, 0xA5, 0x5C},     // ¥
+            {0xB0, 0xB0, 0xDF},     // ° (the semi-voiced mark)
+            {0xB5, 0xB5, 0xE4},     // µ
+            {0xDF, 0xDF, 0xE2},     // ß (β)
+            {0xE4, 0xE4, 0xE1},     // ä
+            {0xF1, 0xF1, 0xEE},     // ñ
+            {0xF6, 0xF6, 0xEF},     // ö
+            {0xF7, 0xF7, 0xFD},     // ÷
+            {0xFC, 0xFC, 0xF5},     // ü
+            {0x3A3, 0x3A3, 0xF6},   // Σ
+            {0x3A9, 0x3A9, 0xF4},   // Ω
+            {0x3B1, 0x3B1, 0xE0},   // α
+            {0x3B2, 0x3B2, 0xE2},   // β
+            {0x3B5, 0x3B5, 0xE3},   // ε
+            {0x3B8, 0x3B8, 0xF2},   // θ
+            {0x3BC, 0x3BC, 0xE4},   // μ
+            {0x3C0, 0x3C0, 0xF7},   // π
+            {0x3C1, 0x3C1, 0xE6},   // ρ
+            {0x3C3, 0x3C3, 0xE5},   // σ
+            {0x2126, 0x2126, 0xF4}, // Ω (ohm sign)
+            {0x2190, 0x2190, 0x7F}, // ←
+            {0x2192, 0x2192, 0x7E}, // →
+            {0x221A, 0x221A, 0xE8}, // √
+            {0x221E, 0x221E, 0xF3}, // ∞
+            {0x2588, 0x2588, 0xFF}, // █
+            {0x3001, 0x3001, 0xA4}, // 、
+            {0x3002, 0x3002, 0xA1}, // 。
+            {0x300C, 0x300D, 0xA2}, // 「 」
+            {0x30FB, 0x30FB, 0xA5}, // ・
+            {0x30FC, 0x30FC, 0xB0}, // ー
+            {0x4E07, 0x4E07, 0xFB}, // 万
+            {0x5186, 0x5186, 0xFC}, // 円
+            {0x5343, 0x5343, 0xFA}, // 千
+            {0xFF61, 0xFF9F, 0xA1}, // half width katakana
+        };
+
+        inline constexpr Range A02_RANGES[] = {
+            {0x20, 0x7E, 0x20},     // ASCII
+            {0xA1, 0xA7, 0xA1},     // ¡ ¢ £ ¤ ¥ ¦ §
+            {0xA9, 0xAB, 0xA9},     // © ª «
+            {0xAE, 0xAE, 0xAE},     // ®
+            {0xB0, 0xB3, 0xB0},     // ° ± ² ³
+            {0xB5, 0xB7, 0xB5},     // µ ¶ ·
+            {0xB9, 0xBF, 0xB9},     // ¹ º » ¼ ½ ¾ ¿
+            {0xC0, 0xFF, 0xC0},     // Latin-1 letters, × and ÷
+            {0x192, 0x192, 0xA8},   // ƒ
+            {0x393, 0x393, 0x92},   // Γ
+            {0x398, 0x398, 0x99},   // Θ
+            {0x3A3, 0x3A3, 0x94},   // Σ
+            {0x3A9, 0x3A9, 0x9A},   // Ω
+            {0x3B1, 0x3B1, 0x90},   // α
+            {0x3B4, 0x3B4, 0x9B},   // δ
+            {0x3B5, 0x3B5, 0x9E},   // ε
+            {0x3BC, 0x3BC, 0xB5},   // μ
+            {0x3C0, 0x3C0, 0x93},   // π
+            {0x3C3, 0x3C3, 0x95},   // σ
+            {0x3C4, 0x3C4, 0x97},   // τ
+            {0x411, 0x411, 0x80},   // Б
+            {0x414, 0x414, 0x81},   // Д
+            {0x416, 0x419, 0x82},   // Ж З И Й
+            {0x41B, 0x41B, 0x86},   // Л
+            {0x41F, 0x41F, 0x87},   // П
+            {0x423, 0x423, 0x88},   // У
+            {0x426, 0x42B, 0x89},   // Ц Ч Ш Щ Ъ Ы
+            {0x42D, 0x42D, 0x8F},   // Э
+            {0x42E, 0x42F, 0xAC},   // Ю Я
+            {0x201C, 0x201D, 0x12}, // “ ”
+            {0x2126, 0x2126, 0x9A}, // Ω (ohm sign)
+            {0x2190, 0x2190, 0x1B}, // ←
+            {0x2191, 0x2191, 0x18}, // ↑
+            {0x2192, 0x2192, 0x1A}, // →
+            {0x2193, 0x2193, 0x19}, // ↓
+            {0x21B5, 0x21B5, 0x17}, // ↵
+            {0x221E, 0x221E, 0x9C}, // ∞
+            {0x2229, 0x2229, 0x9F}, // ∩
+            {0x2264, 0x2265, 0x1C}, // ≤ ≥
+            {0x2302, 0x2302, 0x7F}, // ⌂
+            {0x25B2, 0x25B2, 0x1E}, // ▲
+            {0x25B6, 0x25B6, 0x10}, // ▶
+            {0x25BC, 0x25BC, 0x1F}, // ▼
+            {0x25C0, 0x25C0, 0x11}, // ◀
+            {0x2665, 0x2665, 0x9D}, // ♥
+            {0x266A, 0x266A, 0x91}, // ♪
+            {0x266B, 0x266B, 0x96}, // ♫
+        };
+
+        // full width katakana U+30A1 to U+30FA on A00: half width code | voicing mark << 8, 0 if missing
+        static constexpr char32_t KATAKANA_FIRST = 0x30A1;
+        inline constexpr uint16_t KATAKANA[] = {
+            0x00A7, 0x00B1, 0x00A8, 0x00B2, 0x00A9, 0x00B3, 0x00AA, 0x00B4,
+            0x00AB, 0x00B5, 0x00B6, 0xDEB6, 0x00B7, 0xDEB7, 0x00B8, 0xDEB8,
+            0x00B9, 0xDEB9, 0x00BA, 0xDEBA, 0x00BB, 0xDEBB, 0x00BC, 0xDEBC,
+            0x00BD, 0xDEBD, 0x00BE, 0xDEBE, 0x00BF, 0xDEBF, 0x00C0, 0xDEC0,
+            0x00C1, 0xDEC1, 0x00AF, 0x00C2, 0xDEC2, 0x00C3, 0xDEC3, 0x00C4,
+            0xDEC4, 0x00C5, 0x00C6, 0x00C7, 0x00C8, 0x00C9, 0x00CA, 0xDECA,
+            0xDFCA, 0x00CB, 0xDECB, 0xDFCB, 0x00CC, 0xDECC, 0xDFCC, 0x00CD,
+            0xDECD, 0xDFCD, 0x00CE, 0xDECE, 0xDFCE, 0x00CF, 0x00D0, 0x00D1,
+            0x00D2, 0x00D3, 0x00AC, 0x00D4, 0x00AD, 0x00D5, 0x00AE, 0x00D6,
+            0x00D7, 0x00D8, 0x00D9, 0x00DA, 0x00DB, 0x0000, 0x00DC, 0x0000,
+            0x0000, 0x00A6, 0x00DD, 0xDEB3, 0x0000, 0x0000, 0xDEDC, 0x0000,
+            0x0000, 0xDEA6};
+
+        // sorted by code point
+        inline constexpr Glyph GLYPHS[] = {
+            {0x5C, {0b00000, 0b10000, 0b01000, 0b00100, 0b00010, 0b00001, 0b00000, 0b00000}},   // '\'
+            {0x7E, {0b00000, 0b00000, 0b01000, 0b10101, 0b00010, 0b00000, 0b00000, 0b00000}},   // ~
+            {0xC4, {0b01010, 0b00000, 0b01110, 0b10001, 0b11111, 0b10001, 0b10001, 0b00000}},   // Ä
+            {0xD6, {0b01010, 0b00000, 0b01110, 0b10001, 0b10001, 0b10001, 0b01110, 0b00000}},   // Ö
+            {0xDC, {0b01010, 0b00000, 0b10001, 0b10001, 0b10001, 0b10001, 0b01110, 0b00000}},   // Ü
+            {0xE0, {0b01000, 0b00100, 0b01110, 0b00001, 0b01111, 0b10001, 0b01111, 0b00000}},   // à
+            {0xE8, {0b01000, 0b00100, 0b01110, 0b10001, 0b11111, 0b10000, 0b01110, 0b00000}},   // è
+            {0xE9, {0b00010, 0b00100, 0b01110, 0b10001, 0b11111, 0b10000, 0b01110, 0b00000}},   // é
+            {0x20AC, {0b00110, 0b01001, 0b11100, 0b01000, 0b11100, 0b01001, 0b00110, 0b00000}}, // €
+        };
+
+        template <size_t size>
+        constexpr bool isSorted(const Range (&ranges)[size])
+        {
+            for (size_t i = 0; i < size; i++)
+            {
+                if (ranges[i].first > ranges[i].last || (i && ranges[i - 1].last >= ranges[i].first))
+                    return false;
+            }
+            return true;
+        }
+
+        static_assert(isSorted(A00_RANGES) && isSorted(A02_RANGES), "ranges have to be sorted and must not overlap");
+
+        // direct lookup for code points below 0x80, so that ASCII text doesn't need a search
+        template <size_t size>
+        constexpr std::array<uint8_t, 0x80> asciiCodes(const Range (&ranges)[size])
+        {
+            std::array<uint8_t, 0x80> codes = {};
+            for (uint8_t c = 0; c < 0x80; c++)
+                codes[c] = c < 0x20 ? c : NO_CODE;
+            for (const Range &range : ranges)
+            {
+                for (char32_t c = range.first; c <= range.last && c < 0x80; c++)
+                    codes[c] = range.code + (c - range.first);
+            }
+            return codes;
+        }
+
+        inline constexpr std::array<uint8_t, 0x80> A00_ASCII = asciiCodes(A00_RANGES);
+        inline constexpr std::array<uint8_t, 0x80> A02_ASCII = asciiCodes(A02_RANGES);
+
+        inline char32_t decodeUtf8(std::string_view text, size_t &index)
+        {
+            uint8_t lead = text[index++];
+            if (lead < 0x80)
+                return lead;
+
+            // number of continuation bytes, 0 for continuation bytes and invalid lead bytes
+            uint8_t length = lead >= 0xF8 ? 0 : lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC2 ? 1 : 0;
+            if (!length || index + length > text.size())
+                return REPLACEMENT_CHARACTER;
+
+            char32_t codePoint = lead & (0x3F >> length);
+            for (uint8_t i = 0; i < length; i++)
+            {
+                uint8_t next = text[index + i];
+                if ((next & 0xC0) != 0x80)
+                    return REPLACEMENT_CHARACTER;
+                codePoint = codePoint << 6 | (next & 0x3F);
+            }
+
+            // overlong encodings, UTF-16 surrogates and code points above U+10FFFF
+            static constexpr char32_t SHORTEST[] = {0, 0x80, 0x800, 0x10000};
+            if (codePoint < SHORTEST[length] || (codePoint >= 0xD800 && codePoint <= 0xDFFF) || codePoint > 0x10FFFF)
+                return REPLACEMENT_CHARACTER;
+
+            index += length;
+            return codePoint;
+        }
+
+        inline uint8_t toROM(Charset charset, char32_t codePoint, uint8_t (&codes)[2])
+        {
+            if (codePoint < 0x80)
+            {
+                codes[0] = charset == Charset::A02 ? A02_ASCII[codePoint] : A00_ASCII[codePoint];
+                return codes[0] == NO_CODE ? 0 : 1;
+            }
+
+            if (charset == Charset::A00 && codePoint - KATAKANA_FIRST < sizeof(KATAKANA) / sizeof(KATAKANA[0]))
+            {
+                uint16_t entry = KATAKANA[codePoint - KATAKANA_FIRST];
+                codes[0] = entry;
+                codes[1] = entry >> 8;
+                return !entry ? 0 : codes[1] ? 2 : 1;
+            }
+
+            const Range *begin = charset == Charset::A02 ? std::begin(A02_RANGES) : std::begin(A00_RANGES);
+            const Range *end = charset == Charset::A02 ? std::end(A02_RANGES) : std::end(A00_RANGES);
+
+            // the last range that starts at or before the code point
+            const Range *range = std::upper_bound(begin, end, codePoint,
+                                                  [](char32_t value, const Range &range)
+                                                  { return value < range.first; });
+            if (range == begin || codePoint > (--range)->last)
+                return 0;
+
+            codes[0] = range->code + (codePoint - range->first);
+            return 1;
+        }
+
+        inline const Glyph *findGlyph(char32_t codePoint)
+        {
+            const Glyph *glyph = std::lower_bound(std::begin(GLYPHS), std::end(GLYPHS), codePoint,
+                                                  [](const Glyph &glyph, char32_t value)
+                                                  { return glyph.codePoint < value; });
+            if (glyph == std::end(GLYPHS) || glyph->codePoint != codePoint)
+                return nullptr;
+            return glyph;
+        }
+    }
+}
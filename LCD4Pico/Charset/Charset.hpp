@@ -0,0 +1,59 @@
+#pragma once
+#include "pico/stdlib.h"
+#include <string_view>
+#include <array>
+#include "../Enums.hpp"
+
+namespace lcd4pico
+{
+    namespace charset
+    {
+        static constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+        /**
+         * @brief Code points from `first` to `last` are stored in the ROM one after another, starting at `code`.
+         *
+         */
+        struct Range
+        {
+            char32_t first;
+            char32_t last;
+            uint8_t code;
+        };
+
+        /**
+         * @brief A pattern for the CGRAM, for a character that's missing from the ROM.
+         *
+         */
+        struct Glyph
+        {
+            char32_t codePoint;
+            uint8_t pattern[8];
+        };
+
+        /**
+         * @brief Decodes the UTF-8 sequence at `index` and moves `index` behind it.
+         *        Invalid, truncated and overlong sequences and surrogates return `REPLACEMENT_CHARACTER` and skip one byte.
+         *
+         */
+        char32_t decodeUtf8(std::string_view text, size_t &index);
+
+        /**
+         * @brief Looks a code point up in the character ROM. Code points below 0x20 are kept (0-15 show the CGRAM).
+         *        Full width katakana take two codes on A00 if they have a voicing mark, e.g. "ガ" is "ｶﾞ".
+         *
+         * @param codes The character codes.
+         * @return The number of codes (0 if the ROM doesn't have the character, up to 2).
+         */
+        uint8_t toROM(Charset charset, char32_t codePoint, uint8_t (&codes)[2]);
+
+        /**
+         * @brief A glyph for some characters that are missing from the ROMs, e.g. '\' and '~' on A00, or '€'.
+         *
+         * @return nullptr if there's none.
+         */
+        const Glyph *findGlyph(char32_t codePoint);
+    }
+}
+
+#include "Charset.cpp"
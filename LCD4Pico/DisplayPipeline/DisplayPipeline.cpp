@@ -0,0 +1,83 @@
+#include "pico/stdlib.h"
+#include <string_view>
+#include "DisplayPipeline.hpp"
+
+namespace lcd4pico
+{
+    template <class Geometry>
+    void TextFrame<Geometry>::clear()
+    {
+        for (auto &row : cells)
+            for (auto &cell : row)
+                cell = ' ';
+    }
+
+    template <class Geometry>
+    void TextFrame<Geometry>::print(uint8_t row, uint8_t column, std::string_view text)
+    {
+        if (row >= Geometry::ROWS || column >= Geometry::COLUMNS)
+            return;
+
+        for (size_t i = 0; i < text.size() && column < Geometry::COLUMNS; i++, column++)
+            cells[row][column] = text[i];
+    }
+
+    template <class Geometry>
+    void TextFrame<Geometry>::setRow(uint8_t row, std::string_view text)
+    {
+        if (row >= Geometry::ROWS)
+            return;
+
+        for (uint8_t column = 0; column < Geometry::COLUMNS; column++)
+            cells[row][column] = column < text.size() ? text[column] : ' ';
+    }
+
+    template <class Geometry>
+    std::string_view TextFrame<Geometry>::row(uint8_t row) const
+    {
+        if (row >= Geometry::ROWS)
+            return {};
+        return std::string_view(cells[row], Geometry::COLUMNS);
+    }
+
+    template <class LCD>
+    DisplayPipeline<LCD>::DisplayPipeline(LCD &lcd) : lcd(lcd)
+    {
+    }
+
+    template <class LCD>
+    void DisplayPipeline<LCD>::publish(const Frame &frame)
+    {
+        mailbox.publish(frame);
+    }
+
+    template <class LCD>
+    bool DisplayPipeline<LCD>::poll()
+    {
+        if (const Frame *frame = mailbox.acquire())
+        {
+            // only draws into the buffer, flushStep sends the cells that differ from the display
+            for (uint8_t row = 0; row < LCD::DisplayGeometry::ROWS; row++)
+                lcd.writeRow(row, frame->row(row));
+            taken++;
+        }
+        return lcd.flushStep();
+    }
+
+    template <class LCD>
+    void DisplayPipeline<LCD>::run()
+    {
+        lcd.setBuffered(true);
+        while (true)
+        {
+            if (!poll())
+                tight_loop_contents();
+        }
+    }
+
+    template <class LCD>
+    uint32_t DisplayPipeline<LCD>::framesTaken() const
+    {
+        return taken;
+    }
+}
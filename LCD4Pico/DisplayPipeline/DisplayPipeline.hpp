@@ -0,0 +1,94 @@
+#pragma once
+#include "pico/stdlib.h"
+#include <string_view>
+#include "../Mailbox/Mailbox.hpp"
+
+namespace lcd4pico
+{
+    /**
+     * @brief The characters of a whole screen, built by the application and handed to a `DisplayPipeline`.
+     *
+     * @tparam Geometry Size of the display, e.g. `Geometry16x2`.
+     */
+    template <class Geometry>
+    struct TextFrame
+    {
+        char cells[Geometry::ROWS][Geometry::COLUMNS];
+
+        TextFrame() { clear(); }
+
+        /**
+         * @brief Fills the whole frame with spaces.
+         *
+         */
+        void clear();
+
+        /**
+         * @brief Writes `text` at a row and column, it's cut at the end of the row. Positions outside the frame are ignored.
+         *
+         */
+        void print(uint8_t row, uint8_t column, std::string_view text);
+
+        /**
+         * @brief Replaces a whole row, the rest of the row is filled with spaces.
+         *
+         */
+        void setRow(uint8_t row, std::string_view text);
+
+        std::string_view row(uint8_t row) const;
+    };
+
+    /**
+     * @brief Lets one core own the display while another one publishes frames.
+     *
+     *        The producer (e.g. core 0) calls `publish` with a complete frame, which never waits.
+     *        The display core (e.g. core 1) runs `run`, or calls `poll` from its own loop: it takes the latest frame
+     *        and sends the cells that changed, one transfer per `poll`. Frames published in between replace each other,
+     *        a newer frame takes over in the middle of an update.
+     *
+     *        Keep the producer's frame between updates and only change some fields of it to publish field updates.
+     *
+     * @tparam LCD An `LCD4Pico` type. Only the display core may use it after `run`/`poll` was called.
+     */
+    template <class LCD>
+    class DisplayPipeline
+    {
+    public:
+        using Frame = TextFrame<typename LCD::DisplayGeometry>;
+
+        DisplayPipeline(LCD &lcd);
+
+        /**
+         * @brief Hands a frame to the display core (producer only). Wait-free, the frame is copied.
+         *
+         */
+        void publish(const Frame &frame);
+
+        /**
+         * @brief Takes the latest frame, if there is a new one, and does at most one transfer (display core only).
+         *        The display has to be set up and in buffered mode.
+         *
+         * @return true if something was sent.
+         */
+        bool poll();
+
+        /**
+         * @brief Enables the buffered mode and polls forever, e.g. as the entry function of core 1 (display core only).
+         *
+         */
+        void run();
+
+        /**
+         * @brief Number of frames that were taken from the mailbox, frames that were replaced before are not counted.
+         *
+         */
+        uint32_t framesTaken() const;
+
+    private:
+        LCD &lcd;
+        Mailbox<Frame> mailbox;
+        uint32_t taken = 0;
+    };
+}
+
+#include "DisplayPipeline.cpp"
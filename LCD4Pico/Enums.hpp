@@ -15,4 +15,17 @@ namespace lcd4pico
         Left,
         Right
     };
+
+    enum QueueFullPolicy : const uint8_t
+    {
+        Block, // wait until there's space in the queue
+        Drop   // discard the transfer
+    };
+
+    enum Charset : const uint8_t
+    {
+        Raw, // bytes are sent as they are
+        A00, // character ROM A00: ASCII (with ¥ and arrows instead of \ and ~), katakana, some Greek and math symbols
+        A02  // character ROM A02: ASCII, Western European, Cyrillic and Greek
+    };
 }
\ No newline at end of file
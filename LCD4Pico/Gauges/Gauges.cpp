@@ -0,0 +1,281 @@
+#include "pico/stdlib.h"
+#include "Gauges.hpp"
+
+namespace lcd4pico
+{
+    template <class LCD>
+    Gauges<LCD>::Gauges(LCD &lcd) : lcd(lcd)
+    {
+    }
+
+    template <class LCD>
+    bool Gauges<LCD>::load()
+    {
+        uint8_t rom[2];
+        bool romHasFullBlock = charset::toROM(lcd.selectedCharset(), FULL_BLOCK, rom) == 1;
+
+        for (uint8_t glyph = 0; glyph < 8; glyph++)
+        {
+            const uint8_t(&pattern)[8] = glyph == Columns4 && !romHasFullBlock ? FULL_GLYPH : GLYPHS[glyph];
+            if (!lcd.pinGlyph(pattern))
+                return false;
+            lcd.loadGlyph(pattern, codes[glyph]); // already stored, only looks up the code
+        }
+
+        fullCode = rom[0];
+        if (!romHasFullBlock)
+        {
+            fullCode = codes[Columns4];
+            codes[Columns4] = codes[Columns3];
+        }
+        loaded = true;
+        return true;
+    }
+
+    template <class LCD>
+    bool Gauges<LCD>::fullCell(LCD &lcd, uint8_t &code)
+    {
+        uint8_t rom[2];
+        if (charset::toROM(lcd.selectedCharset(), FULL_BLOCK, rom) == 1)
+        {
+            code = rom[0];
+            return true;
+        }
+        return lcd.loadGlyph(FULL_GLYPH, code);
+    }
+
+    template <class LCD>
+    uint8_t Gauges<LCD>::full() const
+    {
+        return fullCode;
+    }
+
+    template <class LCD>
+    bool Gauges<LCD>::isLoaded() const
+    {
+        return loaded;
+    }
+
+    template <class LCD>
+    uint8_t Gauges<LCD>::code(Glyph glyph) const
+    {
+        return codes[glyph];
+    }
+
+    template <class LCD>
+    uint8_t Gauges<LCD>::horizontalCell(uint8_t columns) const
+    {
+        if (columns == 0)
+            return SPACE;
+        if (columns >= 5)
+            return fullCode;
+        return codes[Columns1 + columns - 1];
+    }
+
+    template <class LCD>
+    uint8_t Gauges<LCD>::verticalCell(uint8_t halves) const
+    {
+        if (halves == 0)
+            return SPACE;
+        if (halves >= 2)
+            return fullCode;
+        return codes[LowerHalf];
+    }
+
+    template <class LCD>
+    bool Gauges<LCD>::drawCell(uint8_t row, uint8_t column, uint8_t code, uint8_t &shown)
+    {
+        if (shown == code)
+            return false;
+
+        lcd.setCursor(row, column); // nothing is sent if the cursor is already there, e.g. for neighbouring cells
+        lcd.writeCustomCharacter(code); // writes any character code
+        shown = code;
+        return true;
+    }
+
+    template <class LCD, const uint8_t width>
+    BarGraph<LCD, width>::BarGraph(Gauges<LCD> &gauges, uint8_t row, uint8_t column) : gauges(gauges),
+                                                                                       row(row),
+                                                                                       column(column)
+    {
+        invalidate();
+    }
+
+    template <class LCD, const uint8_t width>
+    void BarGraph<LCD, width>::set(uint32_t value, uint32_t max)
+    {
+        if (!gauges.isLoaded() && !gauges.load())
+            return;
+
+        uint32_t pixels = width * 5;
+        uint32_t filled = max == 0 || value >= max ? pixels : (uint64_t)value * pixels / max;
+
+        for (uint8_t cell = 0; cell < width; cell++)
+        {
+            uint32_t columns = filled > cell * 5u ? filled - cell * 5u : 0;
+            gauges.drawCell(row, column + cell, gauges.horizontalCell(columns), shown[cell]);
+        }
+    }
+
+    template <class LCD, const uint8_t width>
+    void BarGraph<LCD, width>::invalidate()
+    {
+        for (auto &cell : shown)
+            cell = Gauges<LCD>::UNDRAWN;
+    }
+
+    template <class LCD, const uint8_t height>
+    LevelMeter<LCD, height>::LevelMeter(Gauges<LCD> &gauges, uint8_t bottomRow, uint8_t column) : gauges(gauges),
+                                                                                                   bottomRow(bottomRow),
+                                                                                                   column(column)
+    {
+        invalidate();
+    }
+
+    template <class LCD, const uint8_t height>
+    void LevelMeter<LCD, height>::set(uint32_t value, uint32_t max)
+    {
+        if (!gauges.isLoaded() && !gauges.load())
+            return;
+
+        uint32_t halves = height * 2;
+        uint32_t filled = max == 0 || value >= max ? halves : (uint64_t)value * halves / max;
+
+        for (uint8_t cell = 0; cell < height && cell <= bottomRow; cell++)
+        {
+            uint32_t level = filled > cell * 2u ? filled - cell * 2u : 0;
+            gauges.drawCell(bottomRow - cell, column, gauges.verticalCell(level), shown[cell]);
+        }
+    }
+
+    template <class LCD, const uint8_t height>
+    void LevelMeter<LCD, height>::invalidate()
+    {
+        for (auto &cell : shown)
+            cell = Gauges<LCD>::UNDRAWN;
+    }
+
+    template <class LCD, const uint8_t width, const uint8_t height>
+    Sparkline<LCD, width, height>::Sparkline(Gauges<LCD> &gauges, uint8_t bottomRow, uint8_t column) : gauges(gauges),
+                                                                                                        bottomRow(bottomRow),
+                                                                                                        column(column)
+    {
+        invalidate();
+    }
+
+    template <class LCD, const uint8_t width, const uint8_t height>
+    void Sparkline<LCD, width, height>::push(uint32_t value, uint32_t max)
+    {
+        if (!gauges.isLoaded() && !gauges.load())
+            return;
+
+        for (uint8_t i = 1; i < width; i++)
+            levels[i - 1] = levels[i];
+        levels[width - 1] = max == 0 || value >= max ? height * 2 : (uint64_t)value * height * 2 / max;
+
+        draw();
+    }
+
+    template <class LCD, const uint8_t width, const uint8_t height>
+    void Sparkline<LCD, width, height>::invalidate()
+    {
+        for (auto &row : shown)
+            for (auto &cell : row)
+                cell = Gauges<LCD>::UNDRAWN;
+    }
+
+    template <class LCD, const uint8_t width, const uint8_t height>
+    void Sparkline<LCD, width, height>::draw()
+    {
+        // row by row, so that the changed cells of a row are written as one run
+        for (uint8_t cell = 0; cell < height && cell <= bottomRow; cell++)
+        {
+            for (uint8_t x = 0; x < width; x++)
+            {
+                uint8_t level = levels[x] > cell * 2 ? levels[x] - cell * 2 : 0;
+                gauges.drawCell(bottomRow - cell, column + x, gauges.verticalCell(level), shown[cell][x]);
+            }
+        }
+    }
+
+    template <class LCD, const uint8_t digits>
+    BigNumber<LCD, digits>::BigNumber(Gauges<LCD> &gauges, uint8_t topRow, uint8_t column) : gauges(gauges),
+                                                                                             topRow(topRow),
+                                                                                             column(column)
+    {
+        invalidate();
+    }
+
+    template <class LCD, const uint8_t digits>
+    void BigNumber<LCD, digits>::set(int32_t value)
+    {
+        if (!gauges.isLoaded() && !gauges.load())
+            return;
+
+        // glyphs of the positions from the right
+        uint8_t glyphs[digits];
+        uint32_t magnitude = value < 0 ? 0u - (uint32_t)value : value;
+        uint8_t used = 0;
+        do
+        {
+            if (used < digits)
+                glyphs[used] = magnitude % 10;
+            used++;
+            magnitude /= 10;
+        } while (magnitude);
+        if (value < 0)
+        {
+            if (used < digits)
+                glyphs[used] = MINUS;
+            used++;
+        }
+
+        for (uint8_t position = 0; position < digits; position++)
+        {
+            if (used > digits)
+                glyphs[position] = MINUS;
+            else if (position >= used)
+                glyphs[position] = BLANK;
+        }
+
+        for (uint8_t row = 0; row < 2; row++)
+        {
+            for (uint8_t x = 0; x < WIDTH; x++)
+            {
+                uint8_t position = digits - 1 - x / (DIGIT_WIDTH + 1);
+                uint8_t glyph = glyphs[position];
+                uint8_t offset = x % (DIGIT_WIDTH + 1);
+
+                char s = glyph == BLANK || offset == DIGIT_WIDTH ? ' ' : FONT[glyph][row][offset];
+                gauges.drawCell(topRow + row, column + x, stroke(s), shown[row][x]);
+            }
+        }
+    }
+
+    template <class LCD, const uint8_t digits>
+    void BigNumber<LCD, digits>::invalidate()
+    {
+        for (auto &row : shown)
+            for (auto &cell : row)
+                cell = Gauges<LCD>::UNDRAWN;
+    }
+
+    template <class LCD, const uint8_t digits>
+    uint8_t BigNumber<LCD, digits>::stroke(char stroke) const
+    {
+        switch (stroke)
+        {
+        case 'F':
+            return gauges.full();
+        case 'U':
+            return gauges.code(Gauges<LCD>::TopBar);
+        case 'L':
+            return gauges.code(Gauges<LCD>::BottomBar);
+        case 'B':
+            return gauges.code(Gauges<LCD>::TopAndBottomBar);
+        default:
+            return Gauges<LCD>::SPACE;
+        }
+    }
+}
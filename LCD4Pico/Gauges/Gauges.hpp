@@ -0,0 +1,233 @@
+#pragma once
+#include "pico/stdlib.h"
+#include "../Enums.hpp"
+#include "../Charset/Charset.hpp"
+
+namespace lcd4pico
+{
+    /**
+     * @brief The glyph set shared by the gauges: partial cells for horizontal bars, half cells for vertical bars and
+     *        the strokes of the big digits. The 8 glyphs are loaded and pinned once, value changes never upload glyphs.
+     *        All 8 CGRAM slots are used, so other glyphs can't be loaded while the gauges are in use.
+     *        Full cells use the full block of the character ROM. A02 has none, there it takes the slot of the 4 column cell,
+     *        and bars show 4 columns as 3.
+     *
+     * @tparam LCD An `LCD4Pico` type.
+     */
+    template <class LCD>
+    class Gauges
+    {
+    public:
+        static constexpr uint8_t SPACE = ' ';
+        static constexpr char32_t FULL_BLOCK = 0x2588; // █
+        static constexpr uint8_t UNDRAWN = 0x80; // a cell that wasn't drawn yet, never drawn itself
+
+        enum Glyph : uint8_t
+        {
+            Columns1, // the left 1-4 columns filled
+            Columns2,
+            Columns3,
+            Columns4,
+            TopBar,
+            BottomBar,
+            TopAndBottomBar,
+            LowerHalf
+        };
+
+        static constexpr uint8_t GLYPHS[8][8] = {
+            {0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000, 0b10000},
+            {0b11000, 0b11000, 0b11000, 0b11000, 0b11000, 0b11000, 0b11000, 0b11000},
+            {0b11100, 0b11100, 0b11100, 0b11100, 0b11100, 0b11100, 0b11100, 0b11100},
+            {0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110, 0b11110},
+            {0b11111, 0b11111, 0b11111, 0b00000, 0b00000, 0b00000, 0b00000, 0b00000},
+            {0b00000, 0b00000, 0b00000, 0b00000, 0b00000, 0b11111, 0b11111, 0b11111},
+            {0b11111, 0b11111, 0b11111, 0b00000, 0b00000, 0b11111, 0b11111, 0b11111},
+            {0b00000, 0b00000, 0b00000, 0b00000, 0b11111, 0b11111, 0b11111, 0b11111}};
+        static constexpr uint8_t FULL_GLYPH[8] = {0b11111, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111, 0b11111};
+
+        LCD &lcd;
+
+        Gauges(LCD &lcd);
+
+        /**
+         * @brief Loads and pins the glyph set (the widgets call it on their first update).
+         *
+         * @return false if the glyphs couldn't be loaded, e.g. because other glyphs are pinned.
+         */
+        bool load();
+
+        bool isLoaded() const;
+
+        /**
+         * @brief Character code of a full cell on `lcd` (the charset selected there): the full block of the ROM,
+         *        or a glyph if the ROM has none (A02).
+         *
+         * @return false if a glyph is needed and no CGRAM slot could be freed.
+         */
+        static bool fullCell(LCD &lcd, uint8_t &code);
+
+        uint8_t full() const;
+
+        /**
+         * @brief Character code of a glyph of the set.
+         *
+         */
+        uint8_t code(Glyph glyph) const;
+
+        /**
+         * @brief Character code of a cell with `columns` (0-5) of its 5 columns filled from the left.
+         *
+         */
+        uint8_t horizontalCell(uint8_t columns) const;
+
+        /**
+         * @brief Character code of a cell with `halves` (0-2) of its height filled from the bottom.
+         *
+         */
+        uint8_t verticalCell(uint8_t halves) const;
+
+        /**
+         * @brief Writes `code` to a cell (row and column of the selected page) unless `shown` already holds it,
+         *        then records it in `shown`.
+         *
+         * @return true if the cell was written.
+         */
+        bool drawCell(uint8_t row, uint8_t column, uint8_t code, uint8_t &shown);
+
+    private:
+        uint8_t codes[8] = {};
+        uint8_t fullCode = 0;
+        bool loaded = false;
+    };
+
+    /**
+     * @brief A horizontal bar graph with a resolution of one pixel column (5 per cell).
+     *        Moving the bar by one pixel writes one cell.
+     *
+     */
+    template <class LCD, const uint8_t width>
+    class BarGraph
+    {
+    public:
+        BarGraph(Gauges<LCD> &gauges, uint8_t row, uint8_t column);
+
+        /**
+         * @brief Shows `value` out of `max` and writes only the cells that changed.
+         *
+         */
+        void set(uint32_t value, uint32_t max);
+
+        /**
+         * @brief Forgets what is shown, e.g. after the display was cleared, the next `set` draws every cell.
+         *
+         */
+        void invalidate();
+
+    private:
+        Gauges<LCD> &gauges;
+        const uint8_t row;
+        const uint8_t column;
+        uint8_t shown[width];
+    };
+
+    /**
+     * @brief A vertical bar, filled from `bottomRow` up over `height` rows, with a resolution of half a cell.
+     *
+     */
+    template <class LCD, const uint8_t height>
+    class LevelMeter
+    {
+    public:
+        LevelMeter(Gauges<LCD> &gauges, uint8_t bottomRow, uint8_t column);
+
+        void set(uint32_t value, uint32_t max);
+
+        void invalidate();
+
+    private:
+        Gauges<LCD> &gauges;
+        const uint8_t bottomRow;
+        const uint8_t column;
+        uint8_t shown[height];
+    };
+
+    /**
+     * @brief The last `width` values as vertical bars, the newest on the right.
+     *
+     */
+    template <class LCD, const uint8_t width, const uint8_t height = 2>
+    class Sparkline
+    {
+    public:
+        Sparkline(Gauges<LCD> &gauges, uint8_t bottomRow, uint8_t column);
+
+        /**
+         * @brief Appends a value, the oldest one is dropped. Only the cells that changed are written.
+         *
+         */
+        void push(uint32_t value, uint32_t max);
+
+        void invalidate();
+
+    private:
+        Gauges<LCD> &gauges;
+        const uint8_t bottomRow;
+        const uint8_t column;
+        uint8_t levels[width] = {}; // in half cells
+        uint8_t shown[height][width];
+
+        void draw();
+    };
+
+    /**
+     * @brief A number with digits of 3x2 cells (and one column between the digits), right-aligned.
+     *        Only the cells that differ from the previous number are written.
+     *
+     */
+    template <class LCD, const uint8_t digits>
+    class BigNumber
+    {
+    public:
+        static constexpr uint8_t DIGIT_WIDTH = 3;
+        static constexpr uint8_t WIDTH = digits * (DIGIT_WIDTH + 1) - 1;
+
+        /**
+         * @param topRow The number uses `topRow` and the row below it.
+         */
+        BigNumber(Gauges<LCD> &gauges, uint8_t topRow, uint8_t column);
+
+        /**
+         * @brief Shows `value`, if it doesn't fit into `digits` positions (including a minus sign) all positions show a minus.
+         *
+         */
+        void set(int32_t value);
+
+        void invalidate();
+
+    private:
+        // strokes of 0-9 and the minus sign, top row then bottom row
+        static constexpr char FONT[11][2][DIGIT_WIDTH + 1] = {
+            {"FUF", "FLF"},
+            {"UF ", "LFL"},
+            {"UUF", "FLL"},
+            {"BBF", "LLF"},
+            {"FLF", "  F"},
+            {"FBB", "LLF"},
+            {"FBB", "FLF"},
+            {"UUF", "  F"},
+            {"FBF", "FLF"},
+            {"FBF", "LLF"},
+            {"LL ", "   "}};
+        static constexpr uint8_t MINUS = 10;
+        static constexpr uint8_t BLANK = UINT8_MAX;
+
+        Gauges<LCD> &gauges;
+        const uint8_t topRow;
+        const uint8_t column;
+        uint8_t shown[2][WIDTH];
+
+        uint8_t stroke(char stroke) const;
+    };
+}
+
+#include "Gauges.cpp"
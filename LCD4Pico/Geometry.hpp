@@ -0,0 +1,63 @@
+#pragma once
+#include "pico/stdlib.h"
+
+namespace lcd4pico
+{
+    /**
+     * @brief Size of the display and where its rows are in the DDRAM.
+     *        Row 0 starts at 0x00 and row 1 at 0x40, rows 2 and 3 continue these lines after the last column
+     *        (e.g. 0x14 and 0x54 on a 20x4 display).
+     *
+     */
+    template <const uint8_t columns, const uint8_t rows>
+    struct Geometry
+    {
+        static_assert(rows >= 1 && rows <= 4, "HD44780 displays have 1 to 4 rows");
+        static_assert(columns * ((rows + 1) / 2) <= 40, "a DDRAM line holds 40 characters");
+
+        static constexpr uint8_t COLUMNS = columns;
+        static constexpr uint8_t ROWS = rows;
+
+        static constexpr uint8_t rowAddress(uint8_t row)
+        {
+            return (row & 1 ? 0x40 : 0) + (row >> 1) * columns;
+        }
+
+        static constexpr uint8_t ROW_ADDRESSES[4] = {rowAddress(0), rowAddress(1), rowAddress(2), rowAddress(3)};
+
+        /**
+         * @brief DDRAM address of a position on the display.
+         *
+         */
+        static constexpr uint8_t address(uint8_t row, uint8_t column)
+        {
+            return ROW_ADDRESSES[row & 3] + column;
+        }
+
+        /**
+         * @brief Finds the position of a DDRAM address on the display.
+         *
+         * @return false if the address is not visible (without display shift).
+         */
+        static constexpr bool locate(uint8_t address, uint8_t &row, uint8_t &column)
+        {
+            for (uint8_t r = 0; r < rows; r++)
+            {
+                if (address >= ROW_ADDRESSES[r] && address < ROW_ADDRESSES[r] + columns)
+                {
+                    row = r;
+                    column = address - ROW_ADDRESSES[r];
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    using Geometry16x1 = Geometry<16, 1>;
+    using Geometry16x2 = Geometry<16, 2>;
+    using Geometry16x4 = Geometry<16, 4>;
+    using Geometry20x2 = Geometry<20, 2>;
+    using Geometry20x4 = Geometry<20, 4>;
+    using Geometry40x2 = Geometry<40, 2>;
+}
@@ -0,0 +1,89 @@
+#include "pico/stdlib.h"
+#include "GlyphCache.hpp"
+
+namespace lcd4pico
+{
+    inline uint64_t GlyphCache::key(const uint8_t (&glyph)[8])
+    {
+        uint64_t key = 0;
+        for (auto row : glyph)
+            key = key << 5 | (row & 0b11111);
+        return key;
+    }
+
+    inline uint8_t GlyphCache::find(uint64_t key)
+    {
+        for (uint8_t slot = 0; slot < CGRAM_SLOTS; slot++)
+        {
+            if ((residentSlots & (1 << slot)) && keys[slot] == key)
+            {
+                touch(slot);
+                return slot;
+            }
+        }
+        return NO_SLOT;
+    }
+
+    inline uint8_t GlyphCache::allocate(uint64_t key, uint8_t busySlots)
+    {
+        uint8_t victim = NO_SLOT;
+        for (uint8_t slot = 0; slot < CGRAM_SLOTS; slot++)
+        {
+            if (!(residentSlots & (1 << slot)))
+            {
+                victim = slot;
+                break;
+            }
+            if ((pinnedSlots | busySlots) & (1 << slot))
+                continue;
+            if (victim == NO_SLOT || lastUse[slot] < lastUse[victim])
+                victim = slot;
+        }
+
+        if (victim != NO_SLOT)
+            assign(victim, key);
+        return victim;
+    }
+
+    inline void GlyphCache::assign(uint8_t slot, uint64_t key)
+    {
+        if (slot >= CGRAM_SLOTS)
+            return;
+
+        // a pattern is only kept in one slot
+        for (uint8_t other = 0; other < CGRAM_SLOTS; other++)
+        {
+            if (other != slot && keys[other] == key)
+            {
+                residentSlots &= ~(1 << other);
+                pinnedSlots &= ~(1 << other); // the pin belongs to the pattern, a freed slot must stay reusable
+            }
+        }
+
+        keys[slot] = key;
+        residentSlots |= 1 << slot;
+        touch(slot);
+    }
+
+    inline void GlyphCache::pin(uint8_t slot, bool pinned)
+    {
+        if (slot >= CGRAM_SLOTS)
+            return;
+
+        if (pinned)
+            pinnedSlots |= 1 << slot;
+        else
+            pinnedSlots &= ~(1 << slot);
+    }
+
+    inline void GlyphCache::clear()
+    {
+        residentSlots = 0;
+        pinnedSlots = 0;
+    }
+
+    inline void GlyphCache::touch(uint8_t slot)
+    {
+        lastUse[slot] = ++useCounter;
+    }
+}
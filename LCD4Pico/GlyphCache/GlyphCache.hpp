@@ -0,0 +1,70 @@
+#pragma once
+#include "pico/stdlib.h"
+
+#define CGRAM_SLOTS 8
+
+namespace lcd4pico
+{
+    /**
+     * @brief Keeps track of which glyph is stored in which of the 8 CGRAM slots.
+     *        Glyphs are identified by their content, so the same pattern is only stored once,
+     *        no matter from which array it comes. Slots are reused in least recently used order.
+     *
+     */
+    class GlyphCache
+    {
+    private:
+        uint64_t keys[CGRAM_SLOTS] = {};
+        uint32_t lastUse[CGRAM_SLOTS] = {};
+        uint32_t useCounter = 0;
+        uint8_t residentSlots = 0; // bit mask
+        uint8_t pinnedSlots = 0;   // bit mask
+
+    public:
+        static constexpr uint8_t NO_SLOT = UINT8_MAX;
+
+        /**
+         * @brief Packs the 8 rows of 5 bits into one key, equal keys mean equal glyphs.
+         *
+         */
+        static uint64_t key(const uint8_t (&glyph)[8]);
+
+        /**
+         * @brief Returns the slot holding the glyph and marks it as used, or `NO_SLOT` if it's not stored.
+         *
+         */
+        uint8_t find(uint64_t key);
+
+        /**
+         * @brief Picks a slot for a new glyph: an empty slot if there is one, otherwise the least recently used slot
+         *        that is neither pinned nor in `busySlots`. The slot is recorded as holding `key`, the caller has to upload it.
+         *
+         * @param busySlots Bit mask of slots that must not be replaced, e.g. because they are visible on the display.
+         * @return The slot, or `NO_SLOT` if every slot is pinned or busy.
+         */
+        uint8_t allocate(uint64_t key, uint8_t busySlots);
+
+        /**
+         * @brief Records that `slot` was written directly, e.g. with `createCustomCharacter`.
+         *
+         */
+        void assign(uint8_t slot, uint64_t key);
+
+        /**
+         * @brief A pinned slot is never replaced.
+         *
+         */
+        void pin(uint8_t slot, bool pinned);
+
+        /**
+         * @brief Forgets all slots, e.g. after the display was reset.
+         *
+         */
+        void clear();
+
+    private:
+        void touch(uint8_t slot);
+    };
+}
+
+#include "GlyphCache.cpp"
@@ -0,0 +1,281 @@
+#include <cstdint>
+#include <cstdio>
+#include "Benchmark.hpp"
+#include "../LCD4Pico.hpp"
+#include "../Symbols.hpp"
+
+namespace lcd4pico
+{
+    namespace host
+    {
+        inline Benchmark::Benchmark(const HD44780 &display) : display(display)
+        {
+            start();
+        }
+
+        inline BenchmarkResult Benchmark::snapshot() const
+        {
+            BenchmarkResult result = {};
+            result.busTransactions = display.instructions + display.dataWrites + display.reads;
+            result.instructions = display.instructions;
+            result.dataWrites = display.dataWrites;
+            result.statusReads = display.statusReads;
+            result.gpioWrites = hal().gpioWrites;
+            result.simulated_us = hal().now_ns / 1000;
+            result.wait_us = display.wait_ns / 1000;
+            result.violations = display.violations.size();
+            return result;
+        }
+
+        inline void Benchmark::start()
+        {
+            begin = snapshot();
+        }
+
+        inline BenchmarkResult Benchmark::stop(const char *workload, const char *configuration) const
+        {
+            BenchmarkResult end = snapshot();
+            end.workload = workload;
+            end.configuration = configuration;
+            end.busTransactions -= begin.busTransactions;
+            end.instructions -= begin.instructions;
+            end.dataWrites -= begin.dataWrites;
+            end.statusReads -= begin.statusReads;
+            end.gpioWrites -= begin.gpioWrites;
+            end.simulated_us -= begin.simulated_us;
+            end.wait_us -= begin.wait_us;
+            end.violations -= begin.violations;
+            return end;
+        }
+
+        inline void printHeader(FILE *out)
+        {
+            fprintf(out, "workload,configuration,bus_transactions,instructions,data_writes,status_reads,gpio_writes,simulated_us,wait_us,violations\n");
+        }
+
+        inline void printResult(FILE *out, const BenchmarkResult &result)
+        {
+            fprintf(out, "%s,%s,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu\n",
+                    result.workload,
+                    result.configuration,
+                    (unsigned long long)result.busTransactions,
+                    (unsigned long long)result.instructions,
+                    (unsigned long long)result.dataWrites,
+                    (unsigned long long)result.statusReads,
+                    (unsigned long long)result.gpioWrites,
+                    (unsigned long long)result.simulated_us,
+                    (unsigned long long)result.wait_us,
+                    (unsigned long long)result.violations);
+        }
+
+        namespace workloads
+        {
+            template <class LCD>
+            void fullRedraw(LCD &lcd, uint16_t frames)
+            {
+                char line[17];
+                for (uint16_t frame = 0; frame < frames; frame++)
+                {
+                    snprintf(line, sizeof(line), "Frame %10u", frame);
+                    lcd.clearDisplay();
+                    lcd.writeLines("Temperature 21 C", line);
+                }
+            }
+
+            template <class LCD>
+            void bufferedRedraw(LCD &lcd, uint16_t frames)
+            {
+                char line[17];
+                for (uint16_t frame = 0; frame < frames; frame++)
+                {
+                    snprintf(line, sizeof(line), "Frame %10u", frame);
+                    lcd.clearDisplay();
+                    lcd.writeLines("Temperature 21 C", line);
+                    lcd.flush();
+                }
+            }
+
+            template <class LCD>
+            void counterUpdate(LCD &lcd, uint16_t updates)
+            {
+                char field[6];
+                for (uint16_t update = 0; update < updates; update++)
+                {
+                    snprintf(field, sizeof(field), "%5u", update);
+                    lcd.moveCursorTo(0x40 + 6);
+                    lcd.write(field);
+                }
+            }
+
+            template <class LCD>
+            void marquee(LCD &lcd, uint16_t steps)
+            {
+                for (uint16_t step = 0; step < steps; step++)
+                    lcd.shiftDisplay(Direction::Left);
+            }
+
+            template <class LCD>
+            void customCharacters(LCD &lcd)
+            {
+                lcd.createCustomCharacter(0, symbols::bell);
+                lcd.createCustomCharacter(1, symbols::note);
+                lcd.createCustomCharacter(2, symbols::checkMark);
+                lcd.createCustomCharacter(3, symbols::heart);
+                lcd.createCustomCharacter(4, symbols::clock);
+                lcd.createCustomCharacter(5, symbols::smile);
+                lcd.createCustomCharacter(6, symbols::lock);
+                lcd.createCustomCharacter(7, symbols::speaker);
+            }
+        }
+
+        template <const Bit_Mode bit_mode>
+        PerPinTransport<bit_mode>::PerPinTransport(uint8_t Enable_Pin, uint8_t RS_Pin, const uint8_t (&Data_Pins)[bit_mode])
+            : ENABLEPIN(Enable_Pin), RSPIN(RS_Pin), DATAPINS(Data_Pins)
+        {
+        }
+
+        template <const Bit_Mode bit_mode>
+        void PerPinTransport<bit_mode>::init()
+        {
+            gpio_init(ENABLEPIN);
+            gpio_init(RSPIN);
+            gpio_set_dir(ENABLEPIN, GPIO_OUT);
+            gpio_set_dir(RSPIN, GPIO_OUT);
+            gpio_put(ENABLEPIN, 0);
+            for (uint8_t pin : DATAPINS)
+            {
+                gpio_init(pin);
+                gpio_set_dir(pin, GPIO_OUT);
+            }
+        }
+
+        template <const Bit_Mode bit_mode>
+        void PerPinTransport<bit_mode>::setRegister(bool reg)
+        {
+            gpio_put(RSPIN, reg);
+        }
+
+        template <const Bit_Mode bit_mode>
+        void PerPinTransport<bit_mode>::write(uint8_t data)
+        {
+            if (bit_mode == _8BIT)
+                strobeData(data);
+            else
+            {
+                strobeData(data >> 4);
+                strobeData(data & 0xF);
+            }
+        }
+
+        template <const Bit_Mode bit_mode>
+        void PerPinTransport<bit_mode>::strobeData(uint8_t value)
+        {
+            for (uint8_t pin = 0; pin < bit_mode; pin++)
+                gpio_put(DATAPINS[pin], (value >> pin) & 1);
+            gpio_put(ENABLEPIN, 1);
+            sleep_us(1);
+            gpio_put(ENABLEPIN, 0);
+        }
+
+        template <class Transport>
+        GpioBenchmarkResult measureGpioWrites(Transport &transport, const char *name, const char *configuration, uint16_t bytes)
+        {
+            transport.init();
+            transport.setRegister(DATA_REGISTER);
+            transport.write(0); // the first write may switch the bus direction
+
+            uint64_t writes = hal().gpioWrites;
+            uint64_t start_ns = hal().now_ns;
+            for (uint16_t byte = 0; byte < bytes; byte++)
+                transport.write(byte * 37); // every nibble value, not in order
+
+            GpioBenchmarkResult result;
+            result.transport = name;
+            result.configuration = configuration;
+            result.gpioWritesPerByte = double(hal().gpioWrites - writes) / bytes;
+            result.simulated_nsPerByte = double(hal().now_ns - start_ns) / bytes;
+            return result;
+        }
+
+        inline void runGpioBenchmarks(FILE *out)
+        {
+            const uint8_t dataPins4[] = {4, 5, 6, 7};
+            const uint8_t dataPins8[] = {0, 1, 2, 3, 4, 5, 6, 7};
+            const uint8_t enablePin = 16;
+            const uint8_t rsPin = 18;
+
+            auto print = [out](const GpioBenchmarkResult &result)
+            {
+                fprintf(out, "%s,%s,%.2f,%.0f\n", result.transport, result.configuration,
+                        result.gpioWritesPerByte, result.simulated_nsPerByte);
+            };
+
+            fprintf(out, "transport,configuration,gpio_writes_per_byte,simulated_ns_per_byte\n");
+            {
+                hal().reset();
+                PerPinTransport<_4BIT> transport(enablePin, rsPin, dataPins4);
+                print(measureGpioWrites(transport, "per_pin", "4bit"));
+            }
+            {
+                hal().reset();
+                BitBangTransport<_4BIT> transport(enablePin, rsPin, dataPins4);
+                print(measureGpioWrites(transport, "bit_bang", "4bit"));
+            }
+            {
+                hal().reset();
+                PerPinTransport<_8BIT> transport(enablePin, rsPin, dataPins8);
+                print(measureGpioWrites(transport, "per_pin", "8bit"));
+            }
+            {
+                hal().reset();
+                BitBangTransport<_8BIT> transport(enablePin, rsPin, dataPins8);
+                print(measureGpioWrites(transport, "bit_bang", "8bit"));
+            }
+        }
+
+        inline uint64_t runStandardBenchmarks(FILE *out)
+        {
+            uint64_t violations = 0;
+            const uint8_t dataPins[] = {4, 5, 6, 7};
+            const uint8_t enablePin = 16;
+            const uint8_t rsPin = 18;
+            const uint8_t rwPin = 17;
+
+            printHeader(out);
+            for (bool writeOnly : {false, true})
+            {
+                const char *configuration = writeOnly ? "write_only" : "busy_flag";
+                auto run = [&](const char *workload, auto &&body)
+                {
+                    hal().reset();
+                    HD44780 display(enablePin, rsPin, writeOnly ? NOT_CONNECTED : rwPin, dataPins);
+                    LCD4Pico<_4BIT> lcd = writeOnly ? LCD4Pico<_4BIT>(enablePin, rsPin, dataPins)
+                                                    : LCD4Pico<_4BIT>(enablePin, rsPin, rwPin, dataPins);
+                    lcd.setup();
+
+                    Benchmark benchmark(display);
+                    body(lcd, benchmark);
+                    BenchmarkResult result = benchmark.stop(workload, configuration);
+                    printResult(out, result);
+                    violations += result.violations;
+                };
+
+                run("full_redraw", [](auto &lcd, Benchmark &)
+                    { workloads::fullRedraw(lcd, 10); });
+                run("buffered_redraw", [](auto &lcd, Benchmark &benchmark)
+                    {
+                        lcd.setBuffered(true);
+                        workloads::bufferedRedraw(lcd, 1); // the first flush sends every cell
+                        benchmark.start();
+                        workloads::bufferedRedraw(lcd, 10); });
+                run("counter_update", [](auto &lcd, Benchmark &)
+                    { workloads::counterUpdate(lcd, 100); });
+                run("marquee", [](auto &lcd, Benchmark &)
+                    { workloads::marquee(lcd, 40); });
+                run("custom_characters", [](auto &lcd, Benchmark &)
+                    { workloads::customCharacters(lcd); });
+            }
+            return violations;
+        }
+    }
+}
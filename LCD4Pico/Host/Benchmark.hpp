@@ -0,0 +1,161 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include "Hal.hpp"
+#include "HD44780.hpp"
+#include "../Enums.hpp"
+
+namespace lcd4pico
+{
+    namespace host
+    {
+        /**
+         * @brief Bus and time figures of one workload run against the simulated display.
+         *
+         */
+        struct BenchmarkResult
+        {
+            const char *workload;
+            const char *configuration;
+            uint64_t busTransactions; // instructions + data writes + reads (including busy flag reads)
+            uint64_t instructions;
+            uint64_t dataWrites;
+            uint64_t statusReads;
+            uint64_t gpioWrites;
+            uint64_t simulated_us;
+            uint64_t wait_us; // time between the transfers, i.e. waiting for the display
+            uint64_t violations;
+        };
+
+        /**
+         * @brief Measures the bus traffic and the virtual time between `start` and `stop`.
+         *
+         */
+        class Benchmark
+        {
+        private:
+            const HD44780 &display;
+            BenchmarkResult begin;
+
+            BenchmarkResult snapshot() const;
+
+        public:
+            Benchmark(const HD44780 &display);
+
+            void start();
+
+            BenchmarkResult stop(const char *workload, const char *configuration) const;
+        };
+
+        /**
+         * @brief Prints the CSV header matching `printResult`.
+         *
+         */
+        void printHeader(FILE *out);
+
+        /**
+         * @brief Prints a result as one CSV line.
+         *
+         */
+        void printResult(FILE *out, const BenchmarkResult &result);
+
+        namespace workloads
+        {
+            /**
+             * @brief Clears the display and writes both lines completely, `frames` times.
+             *
+             */
+            template <class LCD>
+            void fullRedraw(LCD &lcd, uint16_t frames);
+
+            /**
+             * @brief Redraws both lines in buffered mode where only a few cells change per frame, `frames` times.
+             *
+             */
+            template <class LCD>
+            void bufferedRedraw(LCD &lcd, uint16_t frames);
+
+            /**
+             * @brief Moves the cursor to a 5 digit field and rewrites it, `updates` times.
+             *
+             */
+            template <class LCD>
+            void counterUpdate(LCD &lcd, uint16_t updates);
+
+            /**
+             * @brief Shifts the display to the left `steps` times.
+             *
+             */
+            template <class LCD>
+            void marquee(LCD &lcd, uint16_t steps);
+
+            /**
+             * @brief Uploads 8 custom characters.
+             *
+             */
+            template <class LCD>
+            void customCharacters(LCD &lcd);
+        }
+
+        /**
+         * @brief The write path before the masked GPIO writes: every data pin is set with its own `gpio_put`
+         *        and E is pulsed separately. Only used as the baseline of `runGpioBenchmarks`.
+         *
+         */
+        template <const Bit_Mode bit_mode>
+        class PerPinTransport
+        {
+        public:
+            const uint8_t ENABLEPIN;
+            const uint8_t RSPIN;
+            const uint8_t (&DATAPINS)[bit_mode];
+
+            PerPinTransport(uint8_t Enable_Pin, uint8_t RS_Pin, const uint8_t (&Data_Pins)[bit_mode]);
+
+            void init();
+
+            void setRegister(bool reg);
+
+            void write(uint8_t data);
+
+        private:
+            void strobeData(uint8_t value);
+        };
+
+        /**
+         * @brief GPIO figures of the write path of a transport, per data byte.
+         *
+         */
+        struct GpioBenchmarkResult
+        {
+            const char *transport;
+            const char *configuration;
+            double gpioWritesPerByte;
+            double simulated_nsPerByte;
+        };
+
+        /**
+         * @brief Writes `bytes` data bytes with changing values through `transport` and counts the GPIO writes.
+         *
+         */
+        template <class Transport>
+        GpioBenchmarkResult measureGpioWrites(Transport &transport, const char *name, const char *configuration, uint16_t bytes = 256);
+
+        /**
+         * @brief Compares the GPIO writes per byte of `PerPinTransport` and `BitBangTransport` in 4bit and 8bit mode
+         *        and prints the results as CSV.
+         *
+         */
+        void runGpioBenchmarks(FILE *out);
+
+        /**
+         * @brief Runs every workload in busy flag mode and in write-only mode on a 16x2 display in 4bit mode
+         *        and prints the results as CSV.
+         *
+         * @return Number of timing violations in all workloads.
+         */
+        uint64_t runStandardBenchmarks(FILE *out);
+    }
+}
+
+#include "Benchmark.cpp"
@@ -0,0 +1,178 @@
+#include <cstdint>
+#include "Dma.hpp"
+
+namespace lcd4pico
+{
+    namespace host
+    {
+        inline Dma::Dma()
+        {
+            hal().attach(*this);
+        }
+
+        inline Dma::~Dma()
+        {
+            hal().detach(*this);
+        }
+
+        inline int Dma::claimUnusedChannel()
+        {
+            for (uint8_t channel = 0; channel < CHANNELS; channel++)
+            {
+                if (!(claimedChannels & (1 << channel)))
+                {
+                    claimedChannels |= 1 << channel;
+                    return channel;
+                }
+            }
+            return -1;
+        }
+
+        inline void Dma::configure(uint8_t channel, const DmaConfig &config, volatile void *writeAddress, const volatile void *readAddress,
+                                   uint32_t count, bool trigger)
+        {
+            channel %= CHANNELS;
+            channels[channel].config = config;
+            channels[channel].writeAddress = (volatile uint8_t *)writeAddress;
+            channels[channel].readAddress = (const volatile uint8_t *)readAddress;
+            registers[channel].transfer_count = count;
+            if (trigger)
+                start(channel, readAddress, count);
+        }
+
+        inline void Dma::start(uint8_t channel, const volatile void *readAddress, uint32_t count)
+        {
+            channel %= CHANNELS;
+            channels[channel].readAddress = (const volatile uint8_t *)readAddress;
+            registers[channel].transfer_count = count;
+            channels[channel].busy = count != 0;
+            service(channel);
+        }
+
+        inline bool Dma::isBusy(uint8_t channel) const
+        {
+            return channels[channel % CHANNELS].busy;
+        }
+
+        inline void Dma::setIrq0Enabled(uint8_t channel, bool enabled)
+        {
+            if (enabled)
+                irq0Enabled |= 1 << (channel % CHANNELS);
+            else
+                irq0Enabled &= ~(1 << (channel % CHANNELS));
+        }
+
+        inline bool Dma::irq0Status(uint8_t channel) const
+        {
+            return irq0Statuses & (1 << (channel % CHANNELS));
+        }
+
+        inline void Dma::acknowledgeIrq0(uint8_t channel)
+        {
+            irq0Statuses &= ~(1 << (channel % CHANNELS));
+        }
+
+        inline void Dma::run(uint64_t until_ns)
+        {
+            (void)until_ns; // the transfers take no time, they only wait for their DREQ
+            for (uint8_t channel = 0; channel < CHANNELS; channel++)
+            {
+                if (channels[channel].busy)
+                    service(channel);
+            }
+        }
+
+        inline void Dma::reset()
+        {
+            for (uint8_t channel = 0; channel < CHANNELS; channel++)
+            {
+                channels[channel] = Channel();
+                registers[channel] = {};
+            }
+            claimedChannels = 0;
+            irq0Enabled = 0;
+            irq0Statuses = 0;
+            transfers = 0;
+        }
+
+        inline bool Dma::isReady(uint8_t dreq) const
+        {
+            if (dreq < 16 && (dreq & 4) == 0) // DREQ_PIO0_TX0 - DREQ_PIO1_TX3
+                return !pio(dreq >> 3).isTxFull(dreq & 3);
+            return dreq == 0x3F;
+        }
+
+        inline const volatile uint8_t *Dma::advance(const volatile uint8_t *address, const Channel &channel, bool ring) const
+        {
+            uintptr_t next = (uintptr_t)address + channel.config.transferSize;
+            if (ring && channel.config.ringSizeBits)
+            {
+                uintptr_t mask = ((uintptr_t)1 << channel.config.ringSizeBits) - 1;
+                next = ((uintptr_t)address & ~mask) | (next & mask);
+            }
+            return (const volatile uint8_t *)next;
+        }
+
+        inline void Dma::service(uint8_t index)
+        {
+            Channel &channel = channels[index];
+            while (channel.busy && isReady(channel.config.dreq))
+            {
+                uint32_t value = 0;
+                switch (channel.config.transferSize)
+                {
+                case 1:
+                    value = *channel.readAddress;
+                    break;
+                case 2:
+                    value = *(const volatile uint16_t *)channel.readAddress;
+                    break;
+                default:
+                    value = *(const volatile uint32_t *)channel.readAddress;
+                    break;
+                }
+
+                uint8_t sm = 0;
+                bool written = false;
+                for (uint8_t block = 0; block < 2 && !written; block++)
+                {
+                    if (pio(block).isTxFifo(channel.writeAddress, sm))
+                    {
+                        pio(block).push(sm, value, hal().now_ns);
+                        written = true;
+                    }
+                }
+                if (!written)
+                {
+                    if (channel.config.transferSize == 1)
+                        *channel.writeAddress = value;
+                    else if (channel.config.transferSize == 2)
+                        *(volatile uint16_t *)channel.writeAddress = value;
+                    else
+                        *(volatile uint32_t *)channel.writeAddress = value;
+                }
+                transfers++;
+
+                if (channel.config.readIncrement)
+                    channel.readAddress = advance(channel.readAddress, channel, !channel.config.ringOnWrite);
+                if (channel.config.writeIncrement)
+                    channel.writeAddress = (volatile uint8_t *)advance(channel.writeAddress, channel, channel.config.ringOnWrite);
+
+                registers[index].transfer_count = registers[index].transfer_count - 1;
+                if (!registers[index].transfer_count)
+                {
+                    channel.busy = false;
+                    irq0Statuses |= 1 << index;
+                    if (irq0Enabled & (1 << index))
+                        hal().raiseIrq(IRQ_0);
+                }
+            }
+        }
+
+        inline Dma &dma()
+        {
+            static Dma instance;
+            return instance;
+        }
+    }
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <cstdint>
+#include "Hal.hpp"
+#include "Pio.hpp"
+
+namespace lcd4pico
+{
+    namespace host
+    {
+        /**
+         * @brief Channel configuration, the host `dma_channel_config`.
+         *
+         */
+        struct DmaConfig
+        {
+            uint8_t transferSize = 4; // bytes
+            bool readIncrement = true;
+            bool writeIncrement = false;
+            uint8_t ringSizeBits = 0; // 0 = no wrap
+            bool ringOnWrite = false;
+            uint8_t dreq = 0x3F; // DREQ_FORCE, unpaced
+        };
+
+        /**
+         * @brief The registers of a channel that the SDK inlines read, see `dma_channel_hw_addr`.
+         *
+         */
+        struct DmaChannelRegisters
+        {
+            volatile uint32_t read_addr;
+            volatile uint32_t write_addr;
+            volatile uint32_t transfer_count;
+            volatile uint32_t ctrl_trig;
+        };
+
+        /**
+         * @brief Model of the DMA controller: the channels copy words as fast as their DREQ allows
+         *        (a PIO TX DREQ is ready while the FIFO isn't full), writes to a PIO TX FIFO register go into the `Pio` model.
+         *        A finished transfer sets the channel's IRQ 0 status and raises `DMA_IRQ_0` if it is enabled for the channel.
+         *
+         */
+        class Dma : public Peripheral
+        {
+        public:
+            static constexpr uint8_t CHANNELS = 12;
+            static constexpr uint8_t IRQ_0 = 11; // DMA_IRQ_0
+
+            DmaChannelRegisters registers[CHANNELS] = {};
+
+            uint64_t transfers = 0;
+
+            /**
+             * @brief Creates the model and attaches it to `hal()`.
+             *
+             */
+            Dma();
+
+            ~Dma();
+
+            Dma(const Dma &) = delete;
+            Dma &operator=(const Dma &) = delete;
+
+            int claimUnusedChannel();
+
+            void configure(uint8_t channel, const DmaConfig &config, volatile void *writeAddress, const volatile void *readAddress,
+                           uint32_t count, bool trigger);
+
+            /**
+             * @brief Starts a transfer of `count` transfers from `readAddress` with the configured write address.
+             *
+             */
+            void start(uint8_t channel, const volatile void *readAddress, uint32_t count);
+
+            bool isBusy(uint8_t channel) const;
+
+            void setIrq0Enabled(uint8_t channel, bool enabled);
+
+            bool irq0Status(uint8_t channel) const;
+
+            void acknowledgeIrq0(uint8_t channel);
+
+            void run(uint64_t until_ns) override;
+
+            void reset() override;
+
+        private:
+            struct Channel
+            {
+                DmaConfig config;
+                const volatile uint8_t *readAddress = nullptr;
+                volatile uint8_t *writeAddress = nullptr;
+                bool busy = false;
+            };
+
+            Channel channels[CHANNELS];
+            uint16_t claimedChannels = 0;
+            uint16_t irq0Enabled = 0;
+            uint16_t irq0Statuses = 0;
+
+            /**
+             * @brief Does the transfers of `channel` its DREQ allows right now.
+             *
+             */
+            void service(uint8_t channel);
+
+            bool isReady(uint8_t dreq) const;
+
+            const volatile uint8_t *advance(const volatile uint8_t *address, const Channel &channel, bool ring) const;
+        };
+
+        /**
+         * @brief The DMA model behind the host `hardware/dma.h`.
+         *
+         */
+        Dma &dma();
+    }
+}
+
+#include "Dma.cpp"
@@ -0,0 +1,393 @@
+#include <cstdint>
+#include <string>
+#include "HD44780.hpp"
+
+namespace lcd4pico
+{
+    namespace host
+    {
+        inline const char *Violation::name() const
+        {
+            switch (kind)
+            {
+            case WriteWhileBusy:
+                return "write while busy";
+            case ReadWhileBusy:
+                return "read while busy";
+            case ShortEnablePulse:
+                return "E pulse too short";
+            case ShortEnableCycle:
+                return "E cycle too short";
+            case ShortAddressSetup:
+                return "RS/RW setup too short";
+            }
+            return "unknown";
+        }
+
+        inline HD44780::HD44780(uint8_t Enable_Pin, uint8_t RS_Pin, uint8_t RW_Pin, const uint8_t (&Data_Pins)[8]) : enablePin(Enable_Pin),
+                                                                                                                      rsPin(RS_Pin),
+                                                                                                                      rwPin(RW_Pin)
+        {
+            for (uint8_t pin = 0; pin < 8; pin++)
+                dataPins[pin] = Data_Pins[pin];
+            reset();
+            hal().attach(*this);
+        }
+
+        inline HD44780::HD44780(uint8_t Enable_Pin, uint8_t RS_Pin, uint8_t RW_Pin, const uint8_t (&Data_Pins)[4]) : enablePin(Enable_Pin),
+                                                                                                                      rsPin(RS_Pin),
+                                                                                                                      rwPin(RW_Pin)
+        {
+            for (uint8_t pin = 0; pin < 4; pin++)
+            {
+                dataPins[pin] = NOT_CONNECTED;
+                dataPins[pin + 4] = Data_Pins[pin];
+            }
+            reset();
+            hal().attach(*this);
+        }
+
+        inline HD44780::~HD44780()
+        {
+            hal().detach(*this);
+        }
+
+        inline void HD44780::reset()
+        {
+            for (auto &cell : ddramCells)
+                cell = ' ';
+            for (auto &cell : cgramCells)
+                cell = 0;
+            ac = 0;
+            cgramSelected = false;
+            incrementCursor = true;
+            accompanyShift = false;
+            eightBitMode = true;
+            twoLines = false;
+            displayOn = false;
+            cursorOn = false;
+            blinkingCursor = false;
+            shift = 0;
+
+            busyUntil_ns = 0;
+            secondNibble = false;
+            driving = false;
+
+            instructions = 0;
+            dataWrites = 0;
+            reads = 0;
+            statusReads = 0;
+            busyReads = 0;
+            wait_ns = 0;
+            violations.clear();
+        }
+
+        inline void HD44780::pinsChanged(uint64_t now_ns)
+        {
+            uint32_t levels = hal().levels();
+            bool e = level(levels, enablePin);
+            bool rs = level(levels, rsPin);
+            bool rw = level(levels, rwPin);
+
+            if (rs != registerSelect || rw != read)
+            {
+                registerSelect = rs;
+                read = rw;
+                controlChange_ns = now_ns;
+            }
+
+            bool statusRead = read && !registerSelect;
+            if (e && !enable) // rising edge
+            {
+                if ((eightBitMode || !secondNibble) && !statusRead)
+                    wait_ns += now_ns - transferEnd_ns;
+
+                if (enableRise_ns && now_ns - enableRise_ns < timing.enableCycleTime_ns)
+                    violation(Violation::ShortEnableCycle, now_ns);
+                if (now_ns - controlChange_ns < timing.addressSetupTime_ns)
+                    violation(Violation::ShortAddressSetup, now_ns);
+
+                enable = true;
+                enableRise_ns = now_ns;
+                if (read)
+                    startRead(now_ns);
+            }
+            else if (!e && enable) // falling edge, writes are latched here
+            {
+                enable = false;
+                if (now_ns - enableRise_ns < timing.enablePulseWidth_ns)
+                    violation(Violation::ShortEnablePulse, now_ns);
+                if ((eightBitMode || secondNibble) && !statusRead)
+                    transferEnd_ns = now_ns;
+
+                if (read)
+                {
+                    driving = false;
+                    if (!eightBitMode)
+                        secondNibble = !secondNibble;
+                    return;
+                }
+
+                uint8_t data = sampleData(levels);
+                if (eightBitMode)
+                    execute(registerSelect, data, now_ns);
+                else if (!secondNibble)
+                {
+                    upperNibble = data & 0xF0;
+                    secondNibble = true;
+                }
+                else
+                {
+                    secondNibble = false;
+                    execute(registerSelect, upperNibble | data >> 4, now_ns);
+                }
+            }
+        }
+
+        inline uint32_t HD44780::drivenPins(uint32_t &values) const
+        {
+            values = 0;
+            if (!driving)
+                return 0;
+
+            // in 4bit mode the upper nibble comes first, both on D4-D7
+            uint8_t data = eightBitMode || !secondNibble ? output : output << 4;
+            uint32_t mask = 0;
+            for (uint8_t bit = 0; bit < 8; bit++)
+            {
+                if (dataPins[bit] == NOT_CONNECTED)
+                    continue;
+                mask |= 1u << dataPins[bit];
+                if (data & (1 << bit))
+                    values |= 1u << dataPins[bit];
+            }
+            return mask;
+        }
+
+        inline bool HD44780::isBusy() const
+        {
+            return hal().now_ns < busyUntil_ns;
+        }
+
+        inline std::string HD44780::render(uint8_t columns, uint8_t rows) const
+        {
+            uint8_t lineLength = twoLines ? 40 : 80;
+            std::string text;
+            for (uint8_t row = 0; row < rows; row++)
+            {
+                if (row)
+                    text += '\n';
+
+                // rows 3 and 4 of four line displays continue rows 1 and 2 in the DDRAM
+                uint8_t line = twoLines ? row % 2 : 0;
+                uint8_t start = twoLines ? row / 2 * columns : row * columns;
+                for (uint8_t column = 0; column < columns; column++)
+                    text += (char)ddramCells[line * 40 + (start + column + shift) % lineLength];
+            }
+            return text;
+        }
+
+        inline uint8_t HD44780::ddram(uint8_t address) const
+        {
+            if (twoLines)
+                return ddramCells[(address & 0x40 ? 40 : 0) + (address & 0x3F) % 40];
+            return ddramCells[address % 80];
+        }
+
+        inline uint8_t HD44780::cgram(uint8_t address) const
+        {
+            return cgramCells[address & 0x3F];
+        }
+
+        inline uint8_t HD44780::addressCounter() const
+        {
+            return ac;
+        }
+
+        inline bool HD44780::isInCGRAM() const
+        {
+            return cgramSelected;
+        }
+
+        inline bool HD44780::isFourBitMode() const
+        {
+            return !eightBitMode;
+        }
+
+        inline bool HD44780::isTwoLineMode() const
+        {
+            return twoLines;
+        }
+
+        inline bool HD44780::isDisplayOn() const
+        {
+            return displayOn;
+        }
+
+        inline bool HD44780::isCursorOn() const
+        {
+            return cursorOn;
+        }
+
+        inline uint8_t HD44780::displayShift() const
+        {
+            return shift;
+        }
+
+        inline bool HD44780::level(uint32_t levels, uint8_t pin) const
+        {
+            if (pin == NOT_CONNECTED)
+                return false;
+            return (levels >> pin) & 1;
+        }
+
+        inline uint8_t HD44780::sampleData(uint32_t levels) const
+        {
+            uint8_t data = 0;
+            for (uint8_t bit = 0; bit < 8; bit++)
+            {
+                if (level(levels, dataPins[bit]))
+                    data |= 1 << bit;
+            }
+            return data;
+        }
+
+        inline void HD44780::violation(Violation::Kind kind, uint64_t now_ns)
+        {
+            violations.push_back({kind, now_ns});
+        }
+
+        inline void HD44780::startRead(uint64_t now_ns)
+        {
+            driving = true;
+            if (!eightBitMode && secondNibble)
+                return; // the byte was already latched with the first nibble
+
+            reads++;
+            bool busy = now_ns < busyUntil_ns;
+            if (!registerSelect)
+            {
+                statusReads++;
+                if (busy)
+                    busyReads++;
+                output = (busy ? 0x80 : 0) | ac;
+                return;
+            }
+
+            if (busy)
+                violation(Violation::ReadWhileBusy, now_ns);
+            output = cgramSelected ? cgramCells[ac & 0x3F] : ddramCells[ramIndex(ac)];
+            ac = stepAddress(ac, incrementCursor);
+            busyUntil_ns = now_ns + timing.instruction_ns;
+        }
+
+        inline void HD44780::execute(bool reg, uint8_t data, uint64_t now_ns)
+        {
+            if (now_ns < busyUntil_ns)
+                violation(Violation::WriteWhileBusy, now_ns);
+            if (recordTransfers)
+                transfers.push_back({reg, data, now_ns});
+
+            if (reg == 0)
+            {
+                executeInstruction(data, now_ns);
+                return;
+            }
+
+            dataWrites++;
+            if (cgramSelected)
+                cgramCells[ac & 0x3F] = data;
+            else
+            {
+                ddramCells[ramIndex(ac)] = data;
+                if (accompanyShift)
+                    shift = (shift + (incrementCursor ? 1 : twoLines ? 39 : 79)) % (twoLines ? 40 : 80);
+            }
+            ac = stepAddress(ac, incrementCursor);
+            busyUntil_ns = now_ns + timing.instruction_ns;
+        }
+
+        inline void HD44780::executeInstruction(uint8_t instruction, uint64_t now_ns)
+        {
+            instructions++;
+            uint8_t lineLength = twoLines ? 40 : 80;
+            uint32_t duration = timing.instruction_ns;
+
+            if (instruction & 0x80) // set DDRAM address
+            {
+                ac = instruction & 0x7F;
+                cgramSelected = false;
+            }
+            else if (instruction & 0x40) // set CGRAM address
+            {
+                ac = instruction & 0x3F;
+                cgramSelected = true;
+            }
+            else if (instruction & 0x20) // function set
+            {
+                eightBitMode = instruction & 0x10;
+                twoLines = instruction & 0x08;
+                secondNibble = false;
+            }
+            else if (instruction & 0x10) // cursor or display shift
+            {
+                bool right = instruction & 0x04;
+                if (instruction & 0x08)
+                    shift = (shift + (right ? lineLength - 1 : 1)) % lineLength;
+                else
+                    ac = stepAddress(ac, right);
+            }
+            else if (instruction & 0x08) // display control
+            {
+                displayOn = instruction & 0x04;
+                cursorOn = instruction & 0x02;
+                blinkingCursor = instruction & 0x01;
+            }
+            else if (instruction & 0x04) // entry mode set
+            {
+                incrementCursor = instruction & 0x02;
+                accompanyShift = instruction & 0x01;
+            }
+            else if (instruction & 0x02) // return home
+            {
+                ac = 0;
+                cgramSelected = false;
+                shift = 0;
+                duration = timing.clearOrHome_ns;
+            }
+            else if (instruction & 0x01) // clear display
+            {
+                for (auto &cell : ddramCells)
+                    cell = ' ';
+                ac = 0;
+                cgramSelected = false;
+                shift = 0;
+                incrementCursor = true;
+                duration = timing.clearOrHome_ns;
+            }
+
+            busyUntil_ns = now_ns + duration;
+        }
+
+        inline uint8_t HD44780::ramIndex(uint8_t address) const
+        {
+            if (twoLines)
+                return (address & 0x40 ? 40 : 0) + (address & 0x3F) % 40;
+            return address % 80;
+        }
+
+        inline uint8_t HD44780::stepAddress(uint8_t address, bool increment) const
+        {
+            if (cgramSelected)
+                return (address + (increment ? 1 : -1)) & 0x3F;
+
+            if (!twoLines)
+                return increment ? (address + 1) % 80 : (address + 79) % 80;
+
+            // in two line mode the address counter jumps between the end of one line and the head of the other one
+            if (increment)
+                return address == 0x27 ? 0x40 : address == 0x67 ? 0x00 : address + 1;
+            return address == 0x40 ? 0x27 : address == 0x00 ? 0x67 : address - 1;
+        }
+    }
+}
@@ -0,0 +1,170 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Hal.hpp"
+
+#define NOT_CONNECTED UINT8_MAX
+
+namespace lcd4pico
+{
+    namespace host
+    {
+        /**
+         * @brief Execution times and bus timing limits of the controller (datasheet values for fosc = 270 kHz).
+         *
+         */
+        struct HD44780Timing
+        {
+            uint32_t instruction_ns = 37000;
+            uint32_t clearOrHome_ns = 1520000;
+            uint32_t enablePulseWidth_ns = 450;  // PW_EH
+            uint32_t enableCycleTime_ns = 1000;  // t_cycE
+            uint32_t addressSetupTime_ns = 40;   // t_AS, RS and RW before the rising edge of E
+        };
+
+        struct Violation
+        {
+            enum Kind : uint8_t
+            {
+                WriteWhileBusy,
+                ReadWhileBusy,
+                ShortEnablePulse,
+                ShortEnableCycle,
+                ShortAddressSetup
+            };
+
+            Kind kind;
+            uint64_t time_ns;
+
+            const char *name() const;
+        };
+
+        /**
+         * @brief A byte written to the controller, see `HD44780::recordTransfers`.
+         *
+         */
+        struct Transfer
+        {
+            bool data; // data register, otherwise an instruction
+            uint8_t value;
+            uint64_t time_ns;
+        };
+
+        /**
+         * @brief Behavioral model of an HD44780 controller connected to the simulated GPIOs.
+         *        It decodes the E strobes, executes the instructions with their execution times on the virtual clock,
+         *        drives the data pins on reads and records every timing violation.
+         *
+         */
+        class HD44780 : public PinListener
+        {
+        public:
+            HD44780Timing timing;
+
+            uint64_t instructions = 0;
+            uint64_t dataWrites = 0;
+            uint64_t reads = 0;
+            uint64_t statusReads = 0;
+            uint64_t busyReads = 0; // status reads that returned a set busy flag
+            uint64_t wait_ns = 0;   // time between two transfers, including the busy flag polling
+            std::vector<Violation> violations;
+
+            bool recordTransfers = false; // append every written byte to `transfers`
+            std::vector<Transfer> transfers;
+
+            /**
+             * @brief Connects a model to the simulated pins and attaches it to `hal()`.
+             *
+             * @param Data_Pins GPIOs of D0-D7, `NOT_CONNECTED` for unused pins.
+             */
+            HD44780(uint8_t Enable_Pin, uint8_t RS_Pin, uint8_t RW_Pin, const uint8_t (&Data_Pins)[8]);
+
+            /**
+             * @brief Connects a model in 4bit wiring (D0-D3 not connected) to the simulated pins.
+             *
+             * @param Data_Pins GPIOs of D4-D7.
+             */
+            HD44780(uint8_t Enable_Pin, uint8_t RS_Pin, uint8_t RW_Pin, const uint8_t (&Data_Pins)[4]);
+
+            ~HD44780();
+
+            HD44780(const HD44780 &) = delete;
+            HD44780 &operator=(const HD44780 &) = delete;
+
+            /**
+             * @brief Puts the controller into the power-on state: 8bit interface, one line, display off, DDRAM filled with spaces.
+             *
+             */
+            void reset();
+
+            void pinsChanged(uint64_t now_ns) override;
+
+            uint32_t drivenPins(uint32_t &values) const override;
+
+            /**
+             * @brief Whether the controller is still executing the last instruction.
+             *
+             */
+            bool isBusy() const;
+
+            /**
+             * @brief Renders the visible part of the DDRAM, one line per display row; character codes are kept as they are.
+             *
+             */
+            std::string render(uint8_t columns = 16, uint8_t rows = 2) const;
+
+            uint8_t ddram(uint8_t address) const;
+            uint8_t cgram(uint8_t address) const;
+            uint8_t addressCounter() const;
+            bool isInCGRAM() const;
+            bool isFourBitMode() const;
+            bool isTwoLineMode() const;
+            bool isDisplayOn() const;
+            bool isCursorOn() const;
+            uint8_t displayShift() const;
+
+        private:
+            uint8_t enablePin;
+            uint8_t rsPin;
+            uint8_t rwPin;
+            uint8_t dataPins[8];
+
+            uint8_t ddramCells[80];
+            uint8_t cgramCells[64];
+            uint8_t ac;
+            bool cgramSelected;
+            bool incrementCursor;
+            bool accompanyShift;
+            bool eightBitMode;
+            bool twoLines;
+            bool displayOn;
+            bool cursorOn;
+            bool blinkingCursor;
+            uint8_t shift;
+
+            uint64_t busyUntil_ns = 0;
+            bool enable = false;
+            bool registerSelect = false;
+            bool read = false;
+            uint64_t enableRise_ns = 0;
+            uint64_t controlChange_ns = 0;
+            uint64_t transferEnd_ns = 0;
+            bool secondNibble = false;
+            uint8_t upperNibble = 0;
+            uint8_t output = 0;
+            bool driving = false;
+
+            bool level(uint32_t levels, uint8_t pin) const;
+            uint8_t sampleData(uint32_t levels) const;
+            void violation(Violation::Kind kind, uint64_t now_ns);
+            void startRead(uint64_t now_ns);
+            void execute(bool reg, uint8_t data, uint64_t now_ns);
+            void executeInstruction(uint8_t instruction, uint64_t now_ns);
+            uint8_t ramIndex(uint8_t address) const;
+            uint8_t stepAddress(uint8_t address, bool increment) const;
+        };
+    }
+}
+
+#include "HD44780.cpp"
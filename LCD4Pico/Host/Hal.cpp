@@ -0,0 +1,281 @@
+#include <cstdint>
+#include <algorithm>
+#include "Hal.hpp"
+
+namespace lcd4pico
+{
+    namespace host
+    {
+        inline void Hal::attach(PinListener &listener)
+        {
+            listeners.push_back(&listener);
+        }
+
+        inline void Hal::detach(PinListener &listener)
+        {
+            listeners.erase(std::remove(listeners.begin(), listeners.end(), &listener), listeners.end());
+        }
+
+        inline void Hal::attach(I2cDevice &device)
+        {
+            i2cDevices.push_back(&device);
+        }
+
+        inline void Hal::detach(I2cDevice &device)
+        {
+            i2cDevices.erase(std::remove(i2cDevices.begin(), i2cDevices.end(), &device), i2cDevices.end());
+        }
+
+        inline void Hal::attach(Peripheral &peripheral)
+        {
+            peripherals.push_back(&peripheral);
+        }
+
+        inline void Hal::detach(Peripheral &peripheral)
+        {
+            peripherals.erase(std::remove(peripherals.begin(), peripherals.end(), &peripheral), peripherals.end());
+        }
+
+        inline void Hal::reset()
+        {
+            now_ns = 0;
+            outputs = 0;
+            directions = 0;
+            gpioWrites = 0;
+            gpioReads = 0;
+            slept_us = 0;
+            i2cTransactions = 0;
+            i2cBytes = 0;
+            alarms.clear();
+            interruptsEnabled = true;
+            pendingIrqs = 0;
+            for (auto peripheral : peripherals)
+                peripheral->reset();
+        }
+
+        inline uint32_t Hal::levels() const
+        {
+            uint32_t driven = 0;
+            for (auto listener : listeners)
+            {
+                uint32_t values = 0;
+                uint32_t mask = listener->drivenPins(values);
+                driven |= values & mask;
+            }
+            return (outputs & directions) | (driven & ~directions);
+        }
+
+        inline void Hal::init(uint8_t pin)
+        {
+            access();
+            outputs &= ~(1u << pin);
+            directions &= ~(1u << pin);
+            gpioWrites++;
+            notify();
+        }
+
+        inline void Hal::setDirections(uint32_t mask, uint32_t outputMask)
+        {
+            access();
+            directions = (directions & ~mask) | (outputMask & mask);
+            gpioWrites++;
+            notify();
+        }
+
+        inline void Hal::put(uint32_t mask, uint32_t values)
+        {
+            access();
+            outputs = (outputs & ~mask) | (values & mask);
+            gpioWrites++;
+            notify();
+        }
+
+        inline uint32_t Hal::get()
+        {
+            access();
+            gpioReads++;
+            return levels();
+        }
+
+        inline void Hal::drive(uint32_t mask, uint32_t values, uint64_t time_ns)
+        {
+            if (time_ns > now_ns)
+                now_ns = time_ns;
+            uint32_t changed = (outputs ^ values) & mask;
+            outputs ^= changed;
+            if (changed & directions)
+                notify();
+        }
+
+        inline void Hal::driveDirections(uint32_t mask, uint32_t outputMask, uint64_t time_ns)
+        {
+            if (time_ns > now_ns)
+                now_ns = time_ns;
+            uint32_t changed = (directions ^ outputMask) & mask;
+            directions ^= changed;
+            if (changed)
+                notify();
+        }
+
+        inline void Hal::sleep_ns(uint64_t ns)
+        {
+            runAlarms(now_ns + ns);
+        }
+
+        inline uint32_t Hal::i2cInit(uint8_t bus, uint32_t baudrate)
+        {
+            i2cBaudrates[bus & 1] = baudrate;
+            return baudrate;
+        }
+
+        inline bool Hal::i2cWrite(uint8_t bus, uint8_t address, const uint8_t *data, size_t length)
+        {
+            uint64_t bit_ns = 1000000000ull / i2cBaudrates[bus & 1];
+            sleep_ns(10 * bit_ns); // start condition and address byte
+
+            I2cDevice *target = nullptr;
+            for (auto device : i2cDevices)
+            {
+                if (device->acknowledges(bus & 1, address))
+                    target = device;
+            }
+            i2cTransactions++;
+            if (!target)
+            {
+                sleep_ns(bit_ns); // stop condition
+                return false;
+            }
+
+            for (size_t i = 0; i < length; i++)
+            {
+                sleep_ns(9 * bit_ns);
+                target->received(data[i], now_ns);
+                i2cBytes++;
+                notify();
+            }
+            sleep_ns(bit_ns);
+            return true;
+        }
+
+        inline int32_t Hal::addAlarm(uint64_t delay_us, int64_t (*callback)(int32_t id, void *userData), void *userData)
+        {
+            if (alarms.size() >= alarmSlots)
+                return -1;
+            int32_t id = nextAlarmId++;
+            alarms.push_back({id, now_ns + delay_us * 1000, callback, userData});
+            return id;
+        }
+
+        inline bool Hal::cancelAlarm(int32_t id)
+        {
+            auto size = alarms.size();
+            alarms.erase(std::remove_if(alarms.begin(), alarms.end(), [id](const Alarm &alarm)
+                                        { return alarm.id == id; }),
+                         alarms.end());
+            return alarms.size() != size;
+        }
+
+        inline void Hal::addIrqHandler(uint8_t irq, void (*handler)())
+        {
+            irqHandlers[irq & 31].push_back(handler);
+        }
+
+        inline void Hal::raiseIrq(uint8_t irq)
+        {
+            pendingIrqs |= 1u << (irq & 31);
+        }
+
+        inline void Hal::runAlarms(uint64_t until_ns)
+        {
+            do
+            {
+                uint64_t step_ns = until_ns;
+                if (!peripherals.empty() && step_ns > now_ns + peripheralStep_ns)
+                    step_ns = now_ns + peripheralStep_ns;
+
+                fireInterrupts(step_ns);
+                runPeripherals(step_ns);
+                if (step_ns > now_ns)
+                    now_ns = step_ns;
+            } while (now_ns < until_ns);
+        }
+
+        inline void Hal::fireInterrupts(uint64_t until_ns)
+        {
+            while (interruptsEnabled && !inInterrupt)
+            {
+                uint32_t irqs = pendingIrqs & enabledIrqs;
+                if (irqs)
+                {
+                    uint8_t irq = 0;
+                    while (!(irqs & (1u << irq)))
+                        irq++;
+                    pendingIrqs &= ~(1u << irq);
+
+                    inInterrupt = true;
+                    for (auto handler : irqHandlers[irq])
+                        handler();
+                    inInterrupt = false;
+                    continue;
+                }
+
+                auto next = alarms.end();
+                for (auto alarm = alarms.begin(); alarm != alarms.end(); alarm++)
+                {
+                    if (alarm->due_ns <= until_ns && (next == alarms.end() || alarm->due_ns < next->due_ns))
+                        next = alarm;
+                }
+                if (next == alarms.end())
+                    break;
+
+                if (next->due_ns > now_ns)
+                {
+                    uint64_t due_ns = next->due_ns;
+                    runPeripherals(due_ns);
+                    now_ns = due_ns;
+                    if (pendingIrqs & enabledIrqs)
+                        continue; // raised by a peripheral before the alarm
+                }
+
+                Alarm alarm = *next;
+                alarms.erase(next);
+
+                inInterrupt = true;
+                int64_t reschedule_us = alarm.callback(alarm.id, alarm.userData);
+                inInterrupt = false;
+
+                if (reschedule_us < 0)
+                    alarm.due_ns += (uint64_t)-reschedule_us * 1000;
+                else if (reschedule_us > 0)
+                    alarm.due_ns = now_ns + (uint64_t)reschedule_us * 1000;
+                if (reschedule_us)
+                    alarms.push_back(alarm);
+            }
+        }
+
+        inline void Hal::runPeripherals(uint64_t until_ns)
+        {
+            for (auto peripheral : peripherals)
+                peripheral->run(until_ns);
+        }
+
+        inline void Hal::access()
+        {
+            uint64_t until_ns = now_ns + gpioAccess_ns;
+            runPeripherals(until_ns);
+            now_ns = until_ns;
+        }
+
+        inline void Hal::notify()
+        {
+            for (auto listener : listeners)
+                listener->pinsChanged(now_ns);
+        }
+
+        inline Hal &hal()
+        {
+            static Hal instance;
+            return instance;
+        }
+    }
+}
@@ -0,0 +1,243 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace lcd4pico
+{
+    namespace host
+    {
+        /**
+         * @brief Something connected to the GPIOs of the simulated Pico, e.g. an `HD44780` model.
+         *
+         */
+        class PinListener
+        {
+        public:
+            virtual ~PinListener() = default;
+
+            /**
+             * @brief Called after the level of any output pin changed.
+             *
+             * @param now_ns Current virtual time.
+             */
+            virtual void pinsChanged(uint64_t now_ns) = 0;
+
+            /**
+             * @brief Returns the mask of the pins the device currently drives, the levels are written to `values`.
+             *
+             */
+            virtual uint32_t drivenPins(uint32_t &values) const = 0;
+        };
+
+        /**
+         * @brief Something connected to a simulated I2C bus, e.g. a `PCF8574` model.
+         *
+         */
+        class I2cDevice
+        {
+        public:
+            virtual ~I2cDevice() = default;
+
+            /**
+             * @brief Whether the device answers to `address` on I2C bus `bus` (0 or 1).
+             *
+             */
+            virtual bool acknowledges(uint8_t bus, uint8_t address) const = 0;
+
+            /**
+             * @brief Called for every byte written to the device, when its transfer ends.
+             *
+             */
+            virtual void received(uint8_t data, uint64_t now_ns) = 0;
+        };
+
+        /**
+         * @brief Hardware that runs alongside the CPU and may drive pins, e.g. the `Pio` and `Dma` models.
+         *
+         */
+        class Peripheral
+        {
+        public:
+            virtual ~Peripheral() = default;
+
+            /**
+             * @brief Runs the peripheral until `until_ns`. Pins are driven with `Hal::drive` at the time they change.
+             *
+             */
+            virtual void run(uint64_t until_ns) = 0;
+
+            /**
+             * @brief Puts the peripheral into its reset state, called by `Hal::reset`.
+             *
+             */
+            virtual void reset() = 0;
+        };
+
+        /**
+         * @brief A pending alarm of the simulated timer, see `add_alarm_in_us`.
+         *
+         */
+        struct Alarm
+        {
+            int32_t id;
+            uint64_t due_ns;
+            int64_t (*callback)(int32_t id, void *userData);
+            void *userData;
+        };
+
+        /**
+         * @brief State of the simulated GPIOs and the virtual clock behind the host `pico/stdlib.h`.
+         *        Time only advances in `sleep` and by `gpioAccess_ns` for every GPIO access.
+         *        Alarms and interrupt handlers fire while time advances in `sleep`, unless interrupts are disabled.
+         *        Attached peripherals run in steps of at most `peripheralStep_ns` alongside.
+         *
+         */
+        class Hal
+        {
+        private:
+            std::vector<PinListener *> listeners;
+            std::vector<I2cDevice *> i2cDevices;
+            std::vector<Peripheral *> peripherals;
+            std::vector<Alarm> alarms;
+            std::vector<void (*)()> irqHandlers[32];
+            int32_t nextAlarmId = 1;
+            bool inInterrupt = false;
+            uint32_t pendingIrqs = 0;
+
+        public:
+            uint64_t now_ns = 0;
+            uint32_t gpioAccess_ns = 50; // rough cost of one SDK GPIO call at 125 MHz
+            uint32_t sysClock_hz = 125000000;
+
+            uint32_t outputs = 0;    // output latch of every pin
+            uint32_t directions = 0; // 1 = output
+
+            uint64_t gpioWrites = 0;
+            uint64_t gpioReads = 0;
+            uint64_t slept_us = 0;
+
+            uint32_t i2cBaudrates[2] = {100000, 100000};
+            uint64_t i2cTransactions = 0;
+            uint64_t i2cBytes = 0;
+
+            bool interruptsEnabled = true;
+            size_t alarmSlots = 16; // pending alarms at most, like the SDK's default alarm pool
+            uint32_t enabledIrqs = 0;
+            uint32_t peripheralStep_ns = 1000; // upper bound for the interrupt latency of the peripherals
+
+            /**
+             * @brief Connects a device to the pins.
+             *
+             */
+            void attach(PinListener &listener);
+
+            void detach(PinListener &listener);
+
+            /**
+             * @brief Connects a device to the I2C buses.
+             *
+             */
+            void attach(I2cDevice &device);
+
+            void detach(I2cDevice &device);
+
+            /**
+             * @brief Lets a peripheral run alongside the CPU.
+             *
+             */
+            void attach(Peripheral &peripheral);
+
+            void detach(Peripheral &peripheral);
+
+            /**
+             * @brief Resets the pins, the clock and the counters; attached devices stay attached.
+             *
+             */
+            void reset();
+
+            /**
+             * @brief Levels on the wires: the output latch for output pins, the levels driven by the devices for input pins.
+             *
+             */
+            uint32_t levels() const;
+
+            void init(uint8_t pin);
+
+            void setDirections(uint32_t mask, uint32_t outputMask);
+
+            void put(uint32_t mask, uint32_t values);
+
+            uint32_t get();
+
+            /**
+             * @brief Drives output pins from a peripheral at `time_ns`; unlike `put` it doesn't count as a GPIO write.
+             *
+             */
+            void drive(uint32_t mask, uint32_t values, uint64_t time_ns);
+
+            /**
+             * @brief Switches pin directions from a peripheral, see `drive`.
+             *
+             */
+            void driveDirections(uint32_t mask, uint32_t outputMask, uint64_t time_ns);
+
+            void sleep_ns(uint64_t ns);
+
+            uint32_t i2cInit(uint8_t bus, uint32_t baudrate);
+
+            /**
+             * @brief Writes `length` bytes to the device with `address`, the time passes like on the wire
+             *        (start, address, 9 clocks per byte, stop).
+             *
+             * @return false if no device acknowledged the address.
+             */
+            bool i2cWrite(uint8_t bus, uint8_t address, const uint8_t *data, size_t length);
+
+            /**
+             * @brief Calls `callback` in `delay_us`, its return value reschedules it like in the SDK
+             *        (< 0: that many us after the previous due time, > 0: that many us from now, 0: done).
+             *
+             * @return The alarm id, or -1 (`PICO_ERROR_GENERIC`) if all `alarmSlots` are taken.
+             */
+            int32_t addAlarm(uint64_t delay_us, int64_t (*callback)(int32_t id, void *userData), void *userData);
+
+            bool cancelAlarm(int32_t id);
+
+            void addIrqHandler(uint8_t irq, void (*handler)());
+
+            /**
+             * @brief Marks the interrupt `irq` as pending, its handlers run with the next alarms if it is enabled.
+             *
+             */
+            void raiseIrq(uint8_t irq);
+
+            /**
+             * @brief Fires every alarm and interrupt that is due until `until_ns` and advances the clock to it.
+             *
+             */
+            void runAlarms(uint64_t until_ns);
+
+        private:
+            void access();
+
+            void runPeripherals(uint64_t until_ns);
+
+            /**
+             * @brief Fires the interrupts and the alarms that are due until `until_ns`.
+             *
+             */
+            void fireInterrupts(uint64_t until_ns);
+
+            void notify();
+        };
+
+        /**
+         * @brief The HAL instance used by the host `pico/stdlib.h`.
+         *
+         */
+        Hal &hal();
+    }
+}
+
+#include "Hal.cpp"
@@ -0,0 +1,60 @@
+#include <cstdint>
+#include "PCF8574.hpp"
+
+namespace lcd4pico
+{
+    namespace host
+    {
+        inline PCF8574::PCF8574(uint8_t address, const uint8_t (&Output_Pins)[8], uint8_t bus) : ADDRESS(address),
+                                                                                                 BUS(bus)
+        {
+            for (uint8_t i = 0; i < 8; i++)
+                pins[i] = Output_Pins[i];
+            hal().attach(static_cast<I2cDevice &>(*this));
+            hal().attach(static_cast<PinListener &>(*this));
+        }
+
+        inline PCF8574::~PCF8574()
+        {
+            hal().detach(static_cast<I2cDevice &>(*this));
+            hal().detach(static_cast<PinListener &>(*this));
+        }
+
+        inline bool PCF8574::acknowledges(uint8_t bus, uint8_t address) const
+        {
+            return bus == BUS && address == ADDRESS;
+        }
+
+        inline void PCF8574::received(uint8_t data, uint64_t now_ns)
+        {
+            (void)now_ns;
+            latch = data;
+            writes++;
+        }
+
+        inline void PCF8574::pinsChanged(uint64_t now_ns)
+        {
+            (void)now_ns;
+        }
+
+        inline uint32_t PCF8574::drivenPins(uint32_t &values) const
+        {
+            uint32_t mask = 0;
+            values = 0;
+            for (uint8_t i = 0; i < 8; i++)
+            {
+                if (pins[i] == NOT_CONNECTED)
+                    continue;
+                mask |= 1u << pins[i];
+                if (latch & (1u << i))
+                    values |= 1u << pins[i];
+            }
+            return mask;
+        }
+
+        inline uint8_t PCF8574::outputs() const
+        {
+            return latch;
+        }
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include "Hal.hpp"
+#include "HD44780.hpp"
+
+namespace lcd4pico
+{
+    namespace host
+    {
+        /**
+         * @brief Model of a PCF8574 I/O expander, e.g. on an I2C LCD backpack.
+         *        Every byte written to it is put on its 8 outputs, which are wired to simulated GPIOs,
+         *        so an `HD44780` model connected to those GPIOs decodes the expander writes into instructions.
+         *
+         */
+        class PCF8574 : public I2cDevice, public PinListener
+        {
+        public:
+            uint64_t writes = 0;
+
+            /**
+             * @brief Connects a model to the simulated I2C bus and pins and attaches it to `hal()`.
+             *
+             * @param Output_Pins GPIOs the outputs P0-P7 are wired to, `NOT_CONNECTED` for unused outputs.
+             */
+            PCF8574(uint8_t address, const uint8_t (&Output_Pins)[8], uint8_t bus = 0);
+
+            ~PCF8574();
+
+            PCF8574(const PCF8574 &) = delete;
+            PCF8574 &operator=(const PCF8574 &) = delete;
+
+            bool acknowledges(uint8_t bus, uint8_t address) const override;
+
+            void received(uint8_t data, uint64_t now_ns) override;
+
+            void pinsChanged(uint64_t now_ns) override;
+
+            uint32_t drivenPins(uint32_t &values) const override;
+
+            /**
+             * @brief Current level of the outputs P0-P7 (all high after power-on).
+             *
+             */
+            uint8_t outputs() const;
+
+        private:
+            const uint8_t ADDRESS;
+            const uint8_t BUS;
+            uint8_t pins[8];
+            uint8_t latch = 0xFF;
+        };
+    }
+}
+
+#include "PCF8574.cpp"
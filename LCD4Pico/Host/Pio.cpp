@@ -0,0 +1,365 @@
+#include <cstdint>
+#include <cmath>
+#include "Pio.hpp"
+
+namespace lcd4pico
+{
+    namespace host
+    {
+        inline Pio::TxFifoRegister &Pio::TxFifoRegister::operator=(uint32_t word)
+        {
+            pio->push(sm, word, hal().now_ns);
+            return *this;
+        }
+
+        inline Pio::DebugRegister::operator uint32_t() const
+        {
+            return flags;
+        }
+
+        inline Pio::DebugRegister &Pio::DebugRegister::operator=(uint32_t clear)
+        {
+            flags &= ~clear;
+            return *this;
+        }
+
+        inline Pio::Pio(uint8_t index) : INDEX(index)
+        {
+            for (uint8_t sm = 0; sm < STATE_MACHINES; sm++)
+            {
+                txf[sm].pio = this;
+                txf[sm].sm = sm;
+            }
+            hal().attach(*this);
+        }
+
+        inline Pio::~Pio()
+        {
+            hal().detach(*this);
+        }
+
+        inline int Pio::addProgram(const uint16_t *instructions, uint8_t length, int8_t origin)
+        {
+            if (!length || length > INSTRUCTION_MEMORY_SIZE)
+                return -1;
+
+            uint32_t mask = length == 32 ? UINT32_MAX : (1u << length) - 1;
+            int offset = origin;
+            if (offset < 0)
+            {
+                for (offset = INSTRUCTION_MEMORY_SIZE - length; offset >= 0; offset--)
+                {
+                    if (!(usedInstructions & mask << offset))
+                        break;
+                }
+            }
+            if (offset < 0 || offset + length > INSTRUCTION_MEMORY_SIZE || usedInstructions & mask << offset)
+                return -1;
+
+            for (uint8_t i = 0; i < length; i++)
+            {
+                uint16_t instruction = instructions[i];
+                if ((instruction & 0xE000) == 0) // JMP, the target is relative to the program
+                    instruction = (instruction & ~0x1F) | ((instruction + offset) & 0x1F);
+                instructionMemory[offset + i] = instruction;
+            }
+            usedInstructions |= mask << offset;
+            return offset;
+        }
+
+        inline int Pio::claimUnusedStateMachine()
+        {
+            for (uint8_t sm = 0; sm < STATE_MACHINES; sm++)
+            {
+                if (!(claimedStateMachines & (1 << sm)))
+                {
+                    claimedStateMachines |= 1 << sm;
+                    return sm;
+                }
+            }
+            return -1;
+        }
+
+        inline void Pio::initStateMachine(uint8_t sm, uint8_t pc, const PioConfig &config)
+        {
+            StateMachine &machine = stateMachines[sm % STATE_MACHINES];
+            machine = StateMachine();
+            machine.config = config;
+            machine.pc = pc;
+            machine.cycle_ns = (uint64_t)std::lround(config.clkdiv * 1e9 / hal().sysClock_hz);
+            if (!machine.cycle_ns)
+                machine.cycle_ns = 1;
+        }
+
+        inline void Pio::setEnabled(uint8_t sm, bool enabled)
+        {
+            StateMachine &machine = stateMachines[sm % STATE_MACHINES];
+            if (enabled && !machine.enabled)
+                machine.time_ns = hal().now_ns;
+            machine.enabled = enabled;
+        }
+
+        inline bool Pio::push(uint8_t sm, uint32_t word, uint64_t time_ns)
+        {
+            sm %= STATE_MACHINES;
+            if (isTxFull(sm))
+            {
+                fdebug.flags |= 1u << (TXOVER_LSB + sm);
+                return false;
+            }
+            stateMachines[sm].tx.push_back({word, time_ns});
+            return true;
+        }
+
+        inline bool Pio::isTxFull(uint8_t sm) const
+        {
+            const StateMachine &machine = stateMachines[sm % STATE_MACHINES];
+            return machine.tx.size() >= (machine.config.joinTx ? 8u : 4u);
+        }
+
+        inline uint8_t Pio::txLevel(uint8_t sm) const
+        {
+            return stateMachines[sm % STATE_MACHINES].tx.size();
+        }
+
+        inline bool Pio::isTxFifo(const volatile void *address, uint8_t &sm) const
+        {
+            for (uint8_t i = 0; i < STATE_MACHINES; i++)
+            {
+                if (address == &txf[i])
+                {
+                    sm = i;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        inline void Pio::run(uint64_t until_ns)
+        {
+            for (uint8_t sm = 0; sm < STATE_MACHINES; sm++)
+            {
+                if (stateMachines[sm].enabled)
+                    step(sm, until_ns);
+            }
+        }
+
+        inline void Pio::reset()
+        {
+            for (uint8_t sm = 0; sm < STATE_MACHINES; sm++)
+                stateMachines[sm] = StateMachine();
+            for (uint16_t &instruction : instructionMemory)
+                instruction = 0;
+            usedInstructions = 0;
+            claimedStateMachines = 0;
+            fdebug.flags = 0;
+            instructionsExecuted = 0;
+            unsupportedInstructions = 0;
+        }
+
+        inline uint64_t Pio::alignToCycle(const StateMachine &machine, uint64_t time_ns) const
+        {
+            if (time_ns <= machine.time_ns)
+                return machine.time_ns;
+            uint64_t cycles = (time_ns - machine.time_ns + machine.cycle_ns - 1) / machine.cycle_ns;
+            return machine.time_ns + cycles * machine.cycle_ns;
+        }
+
+        inline void Pio::writePins(uint8_t base, uint8_t count, uint32_t values, bool pindirs, uint64_t time_ns)
+        {
+            uint32_t mask = 0;
+            uint32_t levels = 0;
+            for (uint8_t i = 0; i < count; i++)
+            {
+                uint8_t pin = (base + i) % 32;
+                mask |= 1u << pin;
+                if (values & (1u << i))
+                    levels |= 1u << pin;
+            }
+            if (pindirs)
+                hal().driveDirections(mask, levels, time_ns);
+            else
+                hal().drive(mask, levels, time_ns);
+        }
+
+        inline void Pio::step(uint8_t index, uint64_t until_ns)
+        {
+            StateMachine &machine = stateMachines[index];
+            const PioConfig &config = machine.config;
+
+            while (machine.time_ns < until_ns)
+            {
+                if (machine.delay)
+                {
+                    uint64_t cycles = (until_ns - machine.time_ns + machine.cycle_ns - 1) / machine.cycle_ns;
+                    if (cycles > machine.delay)
+                        cycles = machine.delay;
+                    machine.delay -= cycles;
+                    machine.time_ns += cycles * machine.cycle_ns;
+                    continue;
+                }
+
+                uint16_t instruction = instructionMemory[machine.pc];
+                uint8_t field = (instruction >> 8) & 0x1F;
+                uint8_t delayBits = 5 - config.sidesetCount;
+                uint8_t delay = field & ((1 << delayBits) - 1);
+                if (config.sidesetCount)
+                {
+                    uint8_t sideset = field >> delayBits;
+                    uint8_t count = config.sidesetCount;
+                    bool apply = true;
+                    if (config.sidesetOptional)
+                    {
+                        count--;
+                        apply = sideset & (1 << count);
+                        sideset &= (1 << count) - 1;
+                    }
+                    if (apply)
+                        writePins(config.sidesetBase, count, sideset, config.sidesetPindirs, machine.time_ns);
+                }
+
+                uint8_t operation = instruction >> 13;
+                uint8_t destination = (instruction >> 5) & 0x7;
+                uint8_t data = instruction & 0x1F;
+                bool jump = false;
+                uint8_t target = 0;
+
+                if (operation == 0) // JMP
+                {
+                    bool condition = false;
+                    switch (destination)
+                    {
+                    case 0:
+                        condition = true;
+                        break;
+                    case 1:
+                        condition = !machine.x;
+                        break;
+                    case 2:
+                        condition = machine.x--;
+                        break;
+                    case 3:
+                        condition = !machine.y;
+                        break;
+                    case 4:
+                        condition = machine.y--;
+                        break;
+                    case 5:
+                        condition = machine.x != machine.y;
+                        break;
+                    case 7:
+                        condition = machine.osrShifted < config.pullThreshold;
+                        break;
+                    default:
+                        unsupportedInstructions++; // JMP PIN
+                        break;
+                    }
+                    jump = condition;
+                    target = data;
+                }
+                else if (operation == 3) // OUT
+                {
+                    uint8_t bits = data ? data : 32;
+                    uint32_t mask = bits == 32 ? UINT32_MAX : (1u << bits) - 1;
+                    uint32_t value;
+                    if (config.outShiftRight)
+                    {
+                        value = machine.osr & mask;
+                        machine.osr = bits == 32 ? 0 : machine.osr >> bits;
+                    }
+                    else
+                    {
+                        value = bits == 32 ? machine.osr : machine.osr >> (32 - bits);
+                        machine.osr = bits == 32 ? 0 : machine.osr << bits;
+                    }
+                    machine.osrShifted = machine.osrShifted + bits > 32 ? 32 : machine.osrShifted + bits;
+
+                    switch (destination)
+                    {
+                    case 0:
+                        writePins(config.outBase, config.outCount, value, false, machine.time_ns);
+                        break;
+                    case 1:
+                        machine.x = value;
+                        break;
+                    case 2:
+                        machine.y = value;
+                        break;
+                    case 3:
+                        break;
+                    case 4:
+                        writePins(config.outBase, config.outCount, value, true, machine.time_ns);
+                        break;
+                    case 5:
+                        jump = true;
+                        target = value & 0x1F;
+                        break;
+                    default:
+                        unsupportedInstructions++; // ISR, EXEC
+                        break;
+                    }
+                }
+                else if (operation == 4 && (instruction & 0x80)) // PULL
+                {
+                    bool block = instruction & 0x20;
+                    if (machine.tx.empty() || machine.tx.front().time_ns > machine.time_ns)
+                    {
+                        if (block)
+                        {
+                            // stalled until a word arrives, the side-set stays applied
+                            fdebug.flags |= 1u << (TXSTALL_LSB + index);
+                            uint64_t arrival_ns = machine.tx.empty() ? until_ns : machine.tx.front().time_ns;
+                            machine.time_ns = alignToCycle(machine, arrival_ns < until_ns ? arrival_ns : until_ns);
+                            continue;
+                        }
+                        machine.osr = machine.x;
+                    }
+                    else
+                    {
+                        machine.osr = machine.tx.front().word;
+                        machine.tx.pop_front();
+                    }
+                    machine.osrShifted = 0;
+                }
+                else if (operation == 7) // SET
+                {
+                    switch (destination)
+                    {
+                    case 0:
+                        writePins(config.setBase, config.setCount, data, false, machine.time_ns);
+                        break;
+                    case 1:
+                        machine.x = data;
+                        break;
+                    case 2:
+                        machine.y = data;
+                        break;
+                    case 4:
+                        writePins(config.setBase, config.setCount, data, true, machine.time_ns);
+                        break;
+                    default:
+                        unsupportedInstructions++;
+                        break;
+                    }
+                }
+                else
+                    unsupportedInstructions++; // WAIT, IN, PUSH, MOV, IRQ
+
+                instructionsExecuted++;
+                if (jump)
+                    machine.pc = target;
+                else
+                    machine.pc = machine.pc == config.wrapTop ? config.wrapBottom : (machine.pc + 1) % INSTRUCTION_MEMORY_SIZE;
+                machine.delay = delay;
+                machine.time_ns += machine.cycle_ns;
+            }
+        }
+
+        inline Pio &pio(uint8_t index)
+        {
+            static Pio pio0(0);
+            static Pio pio1(1);
+            return index ? pio1 : pio0;
+        }
+    }
+}
@@ -0,0 +1,183 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include "Hal.hpp"
+
+namespace lcd4pico
+{
+    namespace host
+    {
+        /**
+         * @brief State machine configuration, the host `pio_sm_config`.
+         *
+         */
+        struct PioConfig
+        {
+            float clkdiv = 1;
+            uint8_t wrapBottom = 0;
+            uint8_t wrapTop = 31;
+            uint8_t sidesetCount = 0; // including the enable bit if optional
+            bool sidesetOptional = false;
+            bool sidesetPindirs = false;
+            uint8_t sidesetBase = 0;
+            uint8_t setBase = 0;
+            uint8_t setCount = 5;
+            uint8_t outBase = 0;
+            uint8_t outCount = 32;
+            bool outShiftRight = true;
+            bool autopull = false;
+            uint8_t pullThreshold = 32;
+            bool joinTx = false;
+        };
+
+        /**
+         * @brief Cycle model of a PIO block with 4 state machines, TX FIFOs and the FDEBUG register.
+         *        The state machines execute JMP, OUT, PULL and SET with side-set and delay cycles on the virtual clock
+         *        and drive the pins through `Hal::drive`. WAIT, IN, PUSH, MOV and IRQ are not modelled, they are
+         *        counted in `unsupportedInstructions` and executed as NOPs.
+         *
+         */
+        class Pio : public Peripheral
+        {
+        public:
+            static constexpr uint8_t STATE_MACHINES = 4;
+            static constexpr uint8_t INSTRUCTION_MEMORY_SIZE = 32;
+            static constexpr uint8_t TXSTALL_LSB = 24;
+            static constexpr uint8_t TXOVER_LSB = 16;
+
+            /**
+             * @brief A TX FIFO register: writing pushes a word into the FIFO (dropped if it's full), also used as the
+             *        DMA write address.
+             *
+             */
+            class TxFifoRegister
+            {
+            public:
+                TxFifoRegister &operator=(uint32_t word);
+
+            private:
+                friend class Pio;
+                Pio *pio = nullptr;
+                uint8_t sm = 0;
+            };
+
+            /**
+             * @brief The FDEBUG register: the sticky stall and overflow flags, writing 1 clears a flag.
+             *
+             */
+            class DebugRegister
+            {
+            public:
+                operator uint32_t() const;
+                DebugRegister &operator=(uint32_t clear);
+
+            private:
+                friend class Pio;
+                uint32_t flags = 0;
+            };
+
+            const uint8_t INDEX;
+
+            TxFifoRegister txf[STATE_MACHINES];
+            DebugRegister fdebug;
+
+            uint64_t instructionsExecuted = 0;
+            uint64_t unsupportedInstructions = 0;
+
+            /**
+             * @brief Creates the model of PIO block `index` and attaches it to `hal()`.
+             *
+             */
+            explicit Pio(uint8_t index);
+
+            ~Pio();
+
+            Pio(const Pio &) = delete;
+            Pio &operator=(const Pio &) = delete;
+
+            /**
+             * @brief Loads a program into free instruction memory (the highest free offset if `origin` is -1)
+             *        and relocates its jumps.
+             *
+             * @return The offset, or -1 if it doesn't fit.
+             */
+            int addProgram(const uint16_t *instructions, uint8_t length, int8_t origin);
+
+            int claimUnusedStateMachine();
+
+            /**
+             * @brief Stops state machine `sm`, applies `config`, clears its FIFO and registers and sets its program counter.
+             *
+             */
+            void initStateMachine(uint8_t sm, uint8_t pc, const PioConfig &config);
+
+            void setEnabled(uint8_t sm, bool enabled);
+
+            /**
+             * @brief Pushes a word into the TX FIFO of `sm`; the state machine can't pull it before `time_ns`.
+             *
+             * @return false if the FIFO is full (the word is dropped and TXOVER is set).
+             */
+            bool push(uint8_t sm, uint32_t word, uint64_t time_ns);
+
+            bool isTxFull(uint8_t sm) const;
+
+            uint8_t txLevel(uint8_t sm) const;
+
+            /**
+             * @brief Whether `address` is the TX FIFO register of one of the state machines, which is returned in `sm`.
+             *
+             */
+            bool isTxFifo(const volatile void *address, uint8_t &sm) const;
+
+            void run(uint64_t until_ns) override;
+
+            void reset() override;
+
+        private:
+            struct FifoEntry
+            {
+                uint32_t word;
+                uint64_t time_ns;
+            };
+
+            struct StateMachine
+            {
+                PioConfig config;
+                bool enabled = false;
+                uint8_t pc = 0;
+                uint32_t x = 0;
+                uint32_t y = 0;
+                uint32_t osr = 0;
+                uint8_t osrShifted = 32; // 32 = empty
+                uint8_t delay = 0;       // delay cycles left after the last instruction
+                uint64_t time_ns = 0;    // start of the next cycle
+                uint64_t cycle_ns = 8;
+                std::deque<FifoEntry> tx;
+            };
+
+            uint16_t instructionMemory[INSTRUCTION_MEMORY_SIZE] = {};
+            uint32_t usedInstructions = 0;
+            uint8_t claimedStateMachines = 0;
+            StateMachine stateMachines[STATE_MACHINES];
+
+            void step(uint8_t index, uint64_t until_ns);
+
+            /**
+             * @brief Writes `count` bits of `values` to the pins or pin directions from `base` on, wrapping at GPIO 31.
+             *
+             */
+            void writePins(uint8_t base, uint8_t count, uint32_t values, bool pindirs, uint64_t time_ns);
+
+            uint64_t alignToCycle(const StateMachine &machine, uint64_t time_ns) const;
+        };
+
+        /**
+         * @brief The models of the two PIO blocks behind the host `hardware/pio.h`.
+         *
+         */
+        Pio &pio(uint8_t index);
+    }
+}
+
+#include "Pio.cpp"
@@ -0,0 +1,148 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include "TraceReplay.hpp"
+#include "../LCD4PicoBase/LCD4PicoBase.hpp"
+#include "../Transport/BitBangTransport.hpp"
+
+namespace lcd4pico
+{
+    namespace host
+    {
+        inline bool readTrace(FILE *in, RecordedTrace &trace)
+        {
+            char line[128];
+            unsigned bits = 0, events = 0;
+            unsigned long recorded = 0;
+            bool header = false;
+            while (!header && fgets(line, sizeof(line), in))
+                header = sscanf(line, "lcd4pico trace: bits=%u events=%u recorded=%lu", &bits, &events, &recorded) == 3;
+            if (!header || (bits != _4BIT && bits != _8BIT))
+                return false;
+
+            trace.bitMode = (Bit_Mode)bits;
+            trace.recorded = recorded;
+            trace.events.clear();
+
+            char word[16];
+            while (fscanf(in, "%15s", word) == 1)
+            {
+                if (strcmp(word, "end") == 0)
+                    return trace.events.size() == events;
+
+                unsigned long value;
+                if (strlen(word) != 8 || sscanf(word, "%8lx", &value) != 1)
+                    return false;
+                trace.events.push_back({(uint16_t)(value >> 16), (uint8_t)(value >> 8), (uint8_t)value});
+            }
+            return false;
+        }
+
+        template <const Bit_Mode bit_mode>
+        TraceReport replay(const RecordedTrace &trace, const uint8_t (&dataPins)[bit_mode],
+                           uint8_t columns, uint8_t rows, uint32_t longGap_us)
+        {
+            const uint8_t enablePin = 16;
+            const uint8_t rsPin = 18;
+            const uint8_t rwPin = 17;
+
+            hal().reset();
+            HD44780 display(enablePin, rsPin, rwPin, dataPins);
+            BitBangTransport<bit_mode> bus(enablePin, rsPin, rwPin, dataPins);
+            bus.init();
+
+            TraceReport report = {};
+            report.events = trace.events.size();
+            report.complete = trace.recorded == trace.events.size();
+
+            if (!report.complete && bit_mode == _4BIT)
+            {
+                // the reset sequence works from any state, the display just has to be idle afterwards
+                bus.setRegister(INSTRUCTION_REGISTER);
+                for (uint8_t instruction : {FUNCTION_SET | _8BIT_MODE, FUNCTION_SET | _8BIT_MODE, FUNCTION_SET | _8BIT_MODE, FUNCTION_SET})
+                {
+                    bus.writeUpperNibble(instruction);
+                    sleep_us(RESET_WAITING_TIME);
+                }
+            }
+
+            // the address counter at the start of an incomplete trace is unknown, so are the reads until it's set
+            bool addressKnown = report.complete;
+            uint64_t start_us = bus.now();
+            uint64_t elapsed_us = 0;
+            uint32_t gap_us = 0;
+            bool first = true;
+            for (const TraceEvent &event : trace.events)
+            {
+                gap_us += event.delta_us;
+                if (event.flags & Trace::Idle)
+                {
+                    gap_us += (uint32_t)event.data << 16;
+                    continue;
+                }
+
+                if (!first)
+                {
+                    elapsed_us += gap_us;
+                    if (gap_us > report.maxGap_us)
+                        report.maxGap_us = gap_us;
+                    if (gap_us >= longGap_us)
+                        report.longGaps++;
+                }
+                first = false;
+                gap_us = 0;
+                report.transfers++;
+
+                // start the transfer at its recorded time, unless the replay itself is already later
+                uint64_t now_us = bus.now();
+                if (start_us + elapsed_us > now_us)
+                    sleep_us(start_us + elapsed_us - now_us);
+
+                bool data = event.flags & Trace::Data;
+                bus.setRegister(data ? DATA_REGISTER : INSTRUCTION_REGISTER);
+                if (event.flags & Trace::Read)
+                {
+                    uint8_t mask = data ? 0xFF : 0x7F; // the busy flag depends on the replay timing
+                    if ((bus.read() & mask) != (event.data & mask) && addressKnown)
+                        report.readMismatches++;
+                }
+                else if (event.flags & Trace::UpperNibble)
+                    bus.writeUpperNibble(event.data);
+                else
+                {
+                    bus.write(event.data);
+                    // clear, home, set CGRAM or DDRAM address
+                    if (!data && (event.data & (SET_DDRAM | SET_CGRAM) || (event.data && event.data <= 0b11)))
+                        addressKnown = true;
+                }
+            }
+
+            report.duration_us = elapsed_us;
+            report.violations = display.violations.size();
+            report.screen = display.render(columns, rows);
+            return report;
+        }
+
+        inline TraceReport replayTrace(const RecordedTrace &trace, uint8_t columns, uint8_t rows, uint32_t longGap_us)
+        {
+            if (trace.bitMode == _4BIT)
+            {
+                const uint8_t dataPins[] = {4, 5, 6, 7};
+                return replay<_4BIT>(trace, dataPins, columns, rows, longGap_us);
+            }
+            const uint8_t dataPins[] = {0, 1, 2, 3, 4, 5, 6, 7};
+            return replay<_8BIT>(trace, dataPins, columns, rows, longGap_us);
+        }
+
+        inline void printReport(FILE *out, const TraceReport &report)
+        {
+            fprintf(out, "events: %u (%u transfers)%s\n", report.events, report.transfers,
+                    report.complete ? "" : ", the oldest events were overwritten");
+            fprintf(out, "duration: %llu us, longest gap: %u us, long gaps: %u\n",
+                    (unsigned long long)report.duration_us, report.maxGap_us, report.longGaps);
+            fprintf(out, "read mismatches: %u, timing violations: %llu\n",
+                    report.readMismatches, (unsigned long long)report.violations);
+            fprintf(out, "%s", report.screen.c_str());
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "Hal.hpp"
+#include "HD44780.hpp"
+#include "../LCD4PicoBase/Trace.hpp"
+
+namespace lcd4pico
+{
+    namespace host
+    {
+        /**
+         * @brief A trace as printed by `Trace::dump`.
+         *
+         */
+        struct RecordedTrace
+        {
+            Bit_Mode bitMode = _8BIT;
+            uint32_t recorded = 0; // more than the events if the oldest ones were overwritten
+            std::vector<TraceEvent> events;
+        };
+
+        /**
+         * @brief What a replay found out about a trace.
+         *
+         */
+        struct TraceReport
+        {
+            uint32_t events;
+            uint32_t transfers;       // events without the idle ones
+            uint64_t duration_us;     // recorded time from the first to the last transfer
+            uint32_t maxGap_us;       // longest time between the starts of two transfers
+            uint32_t longGaps;        // gaps of at least `longGap_us`
+            uint32_t readMismatches;  // reads that returned something else on the model (for status reads only the address counter is compared)
+            uint64_t violations;      // timing violations of the model, i.e. transfers that came too early
+            bool complete;            // the trace starts at power-on, otherwise the screen is only the part written in the trace
+            std::string screen;
+        };
+
+        /**
+         * @brief Parses the output of `Trace::dump`, lines before the header are skipped.
+         *
+         * @return false if no complete trace was found.
+         */
+        bool readTrace(FILE *in, RecordedTrace &trace);
+
+        /**
+         * @brief Replays a trace on the simulated bus into a fresh `HD44780` model with the recorded gaps between the transfers
+         *        and renders the resulting screen. Resets `hal()`.
+         *
+         *        If the oldest events were overwritten, the model is brought into the traced bus width first.
+         *
+         * @param longGap_us Gaps from this length on are counted in `longGaps`.
+         */
+        TraceReport replayTrace(const RecordedTrace &trace, uint8_t columns = 16, uint8_t rows = 2, uint32_t longGap_us = 1000);
+
+        void printReport(FILE *out, const TraceReport &report);
+    }
+}
+
+#include "TraceReplay.cpp"
@@ -0,0 +1,23 @@
+#pragma once
+// Host replacement for the Pico SDK's hardware/clocks.h.
+#include <cstdint>
+#include "../Hal.hpp"
+
+enum clock_index
+{
+    clk_gpout0 = 0,
+    clk_gpout1,
+    clk_gpout2,
+    clk_gpout3,
+    clk_ref,
+    clk_sys,
+    clk_peri,
+    clk_usb,
+    clk_adc,
+    clk_rtc
+};
+
+static inline uint32_t clock_get_hz(enum clock_index clk_index)
+{
+    return clk_index == clk_sys ? lcd4pico::host::hal().sysClock_hz : 48000000;
+}
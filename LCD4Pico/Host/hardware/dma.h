@@ -0,0 +1,98 @@
+#pragma once
+// Host replacement for the Pico SDK's hardware/dma.h: the channels are the `lcd4pico::host::Dma` model.
+#include <cstdint>
+#include <cstdlib>
+#include "../pico/stdlib.h"
+#include "../Dma.hpp"
+
+#define NUM_DMA_CHANNELS 12
+#define DREQ_FORCE 0x3F
+
+typedef lcd4pico::host::DmaConfig dma_channel_config;
+typedef lcd4pico::host::DmaChannelRegisters dma_channel_hw_t;
+
+enum dma_channel_transfer_size
+{
+    DMA_SIZE_8 = 0,
+    DMA_SIZE_16 = 1,
+    DMA_SIZE_32 = 2
+};
+
+static inline int dma_claim_unused_channel(bool required)
+{
+    int channel = lcd4pico::host::dma().claimUnusedChannel();
+    if (channel < 0 && required)
+    {
+        fprintf(stderr, "dma_claim_unused_channel: no DMA channels are available\n");
+        abort();
+    }
+    return channel;
+}
+
+static inline dma_channel_config dma_channel_get_default_config(uint channel)
+{
+    (void)channel;
+    return dma_channel_config();
+}
+
+static inline void channel_config_set_transfer_data_size(dma_channel_config *c, enum dma_channel_transfer_size size)
+{
+    c->transferSize = 1 << size;
+}
+
+static inline void channel_config_set_read_increment(dma_channel_config *c, bool incr)
+{
+    c->readIncrement = incr;
+}
+
+static inline void channel_config_set_write_increment(dma_channel_config *c, bool incr)
+{
+    c->writeIncrement = incr;
+}
+
+static inline void channel_config_set_ring(dma_channel_config *c, bool write, uint size_bits)
+{
+    c->ringOnWrite = write;
+    c->ringSizeBits = size_bits;
+}
+
+static inline void channel_config_set_dreq(dma_channel_config *c, uint dreq)
+{
+    c->dreq = dreq;
+}
+
+static inline void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                                         const volatile void *read_addr, uint transfer_count, bool trigger)
+{
+    lcd4pico::host::dma().configure(channel, *config, write_addr, read_addr, transfer_count, trigger);
+}
+
+static inline void dma_channel_transfer_from_buffer_now(uint channel, const volatile void *read_addr, uint32_t transfer_count)
+{
+    lcd4pico::host::dma().start(channel, read_addr, transfer_count);
+}
+
+static inline bool dma_channel_is_busy(uint channel)
+{
+    return lcd4pico::host::dma().isBusy(channel);
+}
+
+static inline dma_channel_hw_t *dma_channel_hw_addr(uint channel)
+{
+    return &lcd4pico::host::dma().registers[channel % NUM_DMA_CHANNELS];
+}
+
+static inline void dma_channel_set_irq0_enabled(uint channel, bool enabled)
+{
+    lcd4pico::host::dma().setIrq0Enabled(channel, enabled);
+}
+
+static inline bool dma_channel_get_irq0_status(uint channel)
+{
+    return lcd4pico::host::dma().irq0Status(channel);
+}
+
+static inline void dma_channel_acknowledge_irq0(uint channel)
+{
+    lcd4pico::host::dma().acknowledgeIrq0(channel);
+}
@@ -0,0 +1,31 @@
+#pragma once
+// Host replacement for the Pico SDK's hardware/i2c.h: writes go to the devices attached to `lcd4pico::host::hal()`.
+#include <cstdint>
+#include <cstddef>
+#include "../Hal.hpp"
+
+#ifndef PICO_ERROR_GENERIC
+#define PICO_ERROR_GENERIC -1
+#endif
+
+typedef struct i2c_inst
+{
+    uint8_t index;
+} i2c_inst_t;
+
+inline i2c_inst_t host_i2c0_inst = {0};
+inline i2c_inst_t host_i2c1_inst = {1};
+
+#define i2c0 (&host_i2c0_inst)
+#define i2c1 (&host_i2c1_inst)
+
+static inline unsigned int i2c_init(i2c_inst_t *i2c, unsigned int baudrate)
+{
+    return lcd4pico::host::hal().i2cInit(i2c->index, baudrate);
+}
+
+static inline int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
+{
+    (void)nostop;
+    return lcd4pico::host::hal().i2cWrite(i2c->index, addr, src, len) ? (int)len : PICO_ERROR_GENERIC;
+}
@@ -0,0 +1,24 @@
+#pragma once
+// Host replacement for the Pico SDK's hardware/irq.h: the handlers run like alarms, see `lcd4pico::host::Hal::raiseIrq`.
+#include <cstdint>
+#include "../Hal.hpp"
+
+#define DMA_IRQ_0 11
+#define DMA_IRQ_1 12
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+
+typedef void (*irq_handler_t)();
+
+static inline void irq_add_shared_handler(unsigned int num, irq_handler_t handler, uint8_t order_priority)
+{
+    (void)order_priority;
+    lcd4pico::host::hal().addIrqHandler(num, handler);
+}
+
+static inline void irq_set_enabled(unsigned int num, bool enabled)
+{
+    if (enabled)
+        lcd4pico::host::hal().enabledIrqs |= 1u << num;
+    else
+        lcd4pico::host::hal().enabledIrqs &= ~(1u << num);
+}
@@ -0,0 +1,141 @@
+#pragma once
+// Host replacement for the Pico SDK's hardware/pio.h: the state machines are the `lcd4pico::host::Pio` models.
+#include <cstdint>
+#include <cstdlib>
+#include "../pico/stdlib.h"
+#include "../Pio.hpp"
+
+typedef lcd4pico::host::Pio pio_hw_t;
+typedef pio_hw_t *PIO;
+typedef lcd4pico::host::PioConfig pio_sm_config;
+
+typedef struct pio_program
+{
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin; // required instruction memory origin or -1
+} pio_program_t;
+
+enum pio_fifo_join
+{
+    PIO_FIFO_JOIN_NONE = 0,
+    PIO_FIFO_JOIN_TX = 1,
+    PIO_FIFO_JOIN_RX = 2
+};
+
+#define pio0 (&lcd4pico::host::pio(0))
+#define pio1 (&lcd4pico::host::pio(1))
+
+#define PIO_FDEBUG_TXSTALL_LSB 24
+#define PIO_FDEBUG_TXOVER_LSB 16
+
+static inline uint pio_add_program(PIO pio, const pio_program_t *program)
+{
+    int offset = pio->addProgram(program->instructions, program->length, program->origin);
+    if (offset < 0)
+    {
+        fprintf(stderr, "pio_add_program: no program space\n");
+        abort();
+    }
+    return offset;
+}
+
+static inline int pio_claim_unused_sm(PIO pio, bool required)
+{
+    int sm = pio->claimUnusedStateMachine();
+    if (sm < 0 && required)
+    {
+        fprintf(stderr, "pio_claim_unused_sm: no state machines are available\n");
+        abort();
+    }
+    return sm;
+}
+
+static inline void pio_gpio_init(PIO pio, uint pin)
+{
+    gpio_set_function(pin, pio->INDEX ? GPIO_FUNC_PIO1 : GPIO_FUNC_PIO0);
+}
+
+static inline void pio_sm_set_pins_with_mask(PIO pio, uint sm, uint32_t pin_values, uint32_t pin_mask)
+{
+    (void)pio;
+    (void)sm;
+    lcd4pico::host::hal().drive(pin_mask, pin_values, lcd4pico::host::hal().now_ns);
+}
+
+static inline void pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin_base, uint pin_count, bool is_out)
+{
+    (void)pio;
+    (void)sm;
+    uint32_t mask = 0;
+    for (uint i = 0; i < pin_count; i++)
+        mask |= 1u << ((pin_base + i) % 32);
+    lcd4pico::host::hal().driveDirections(mask, is_out ? mask : 0, lcd4pico::host::hal().now_ns);
+}
+
+static inline pio_sm_config pio_get_default_sm_config()
+{
+    return pio_sm_config();
+}
+
+static inline void sm_config_set_wrap(pio_sm_config *c, uint wrap_target, uint wrap)
+{
+    c->wrapBottom = wrap_target;
+    c->wrapTop = wrap;
+}
+
+static inline void sm_config_set_sideset(pio_sm_config *c, uint bit_count, bool optional, bool pindirs)
+{
+    c->sidesetCount = bit_count;
+    c->sidesetOptional = optional;
+    c->sidesetPindirs = pindirs;
+}
+
+static inline void sm_config_set_sideset_pins(pio_sm_config *c, uint sideset_base)
+{
+    c->sidesetBase = sideset_base;
+}
+
+static inline void sm_config_set_set_pins(pio_sm_config *c, uint set_base, uint set_count)
+{
+    c->setBase = set_base;
+    c->setCount = set_count;
+}
+
+static inline void sm_config_set_out_pins(pio_sm_config *c, uint out_base, uint out_count)
+{
+    c->outBase = out_base;
+    c->outCount = out_count;
+}
+
+static inline void sm_config_set_out_shift(pio_sm_config *c, bool shift_right, bool autopull, uint pull_threshold)
+{
+    c->outShiftRight = shift_right;
+    c->autopull = autopull;
+    c->pullThreshold = pull_threshold;
+}
+
+static inline void sm_config_set_fifo_join(pio_sm_config *c, enum pio_fifo_join join)
+{
+    c->joinTx = join == PIO_FIFO_JOIN_TX;
+}
+
+static inline void sm_config_set_clkdiv(pio_sm_config *c, float div)
+{
+    c->clkdiv = div;
+}
+
+static inline void pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config)
+{
+    pio->initStateMachine(sm, initial_pc, *config);
+}
+
+static inline void pio_sm_set_enabled(PIO pio, uint sm, bool enabled)
+{
+    pio->setEnabled(sm, enabled);
+}
+
+static inline uint pio_get_dreq(PIO pio, uint sm, bool is_tx)
+{
+    return pio->INDEX * 8 + (is_tx ? 0 : 4) + sm;
+}
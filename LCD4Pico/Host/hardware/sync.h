@@ -0,0 +1,18 @@
+#pragma once
+// Host replacement for the Pico SDK's hardware/sync.h: interrupts are the alarms of the simulated timer.
+#include <cstdint>
+#include "../Hal.hpp"
+
+static inline uint32_t save_and_disable_interrupts()
+{
+    uint32_t status = lcd4pico::host::hal().interruptsEnabled;
+    lcd4pico::host::hal().interruptsEnabled = false;
+    return status;
+}
+
+static inline void restore_interrupts(uint32_t status)
+{
+    lcd4pico::host::hal().interruptsEnabled = status;
+    if (status)
+        lcd4pico::host::hal().runAlarms(lcd4pico::host::hal().now_ns); // alarms that became due in between
+}
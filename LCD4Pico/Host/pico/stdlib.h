@@ -0,0 +1,133 @@
+#pragma once
+// Host replacement for the Pico SDK's pico/stdlib.h, put LCD4Pico/Host on the include path
+// instead of the SDK to run the library on a PC against the simulated GPIOs in `lcd4pico::host::hal()`.
+#include <cstdint>
+#include <cstdio>
+#include "../Hal.hpp"
+
+typedef unsigned int uint;
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *user_data);
+
+#ifndef PICO_ERROR_GENERIC
+#define PICO_ERROR_GENERIC -1
+#endif
+
+#define GPIO_IN 0
+#define GPIO_OUT 1
+
+enum gpio_function
+{
+    GPIO_FUNC_SPI = 1,
+    GPIO_FUNC_UART = 2,
+    GPIO_FUNC_I2C = 3,
+    GPIO_FUNC_PIO0 = 6,
+    GPIO_FUNC_PIO1 = 7,
+    GPIO_FUNC_SIO = 5
+};
+
+#ifndef count_of
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#endif
+
+static inline void stdio_init_all()
+{
+}
+
+static inline void tight_loop_contents()
+{
+    lcd4pico::host::hal().sleep_ns(100); // time passes while spinning, so alarms can fire
+}
+
+static inline void gpio_init(uint gpio)
+{
+    lcd4pico::host::hal().init(gpio);
+}
+
+static inline void gpio_set_function(uint gpio, enum gpio_function fn)
+{
+    (void)gpio;
+    (void)fn;
+}
+
+static inline void gpio_pull_up(uint gpio)
+{
+    (void)gpio;
+}
+
+static inline void gpio_set_dir(uint gpio, bool out)
+{
+    lcd4pico::host::hal().setDirections(1u << gpio, out ? 1u << gpio : 0);
+}
+
+static inline void gpio_set_dir_masked(uint32_t mask, uint32_t value)
+{
+    lcd4pico::host::hal().setDirections(mask, value);
+}
+
+static inline void gpio_set_dir_in_masked(uint32_t mask)
+{
+    lcd4pico::host::hal().setDirections(mask, 0);
+}
+
+static inline void gpio_set_dir_out_masked(uint32_t mask)
+{
+    lcd4pico::host::hal().setDirections(mask, mask);
+}
+
+static inline void gpio_put(uint gpio, bool value)
+{
+    lcd4pico::host::hal().put(1u << gpio, value ? 1u << gpio : 0);
+}
+
+static inline void gpio_put_masked(uint32_t mask, uint32_t value)
+{
+    lcd4pico::host::hal().put(mask, value);
+}
+
+static inline bool gpio_get(uint gpio)
+{
+    return (lcd4pico::host::hal().get() >> gpio) & 1;
+}
+
+static inline uint32_t gpio_get_all()
+{
+    return lcd4pico::host::hal().get();
+}
+
+static inline uint64_t time_us_64()
+{
+    return lcd4pico::host::hal().now_ns / 1000;
+}
+
+static inline uint32_t time_us_32()
+{
+    return (uint32_t)time_us_64();
+}
+
+static inline void sleep_us(uint64_t us)
+{
+    lcd4pico::host::hal().slept_us += us;
+    lcd4pico::host::hal().sleep_ns(us * 1000);
+}
+
+static inline void sleep_ms(uint32_t ms)
+{
+    sleep_us((uint64_t)ms * 1000);
+}
+
+static inline void busy_wait_us_32(uint32_t us)
+{
+    sleep_us(us);
+}
+
+static inline alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past)
+{
+    (void)fire_if_past;
+    return lcd4pico::host::hal().addAlarm(us, callback, user_data);
+}
+
+static inline bool cancel_alarm(alarm_id_t alarm_id)
+{
+    return lcd4pico::host::hal().cancelAlarm(alarm_id);
+}
@@ -1,96 +1,372 @@
 #include "pico/stdlib.h"
-#include <string>
+#include <string_view>
+#include <charconv>
 #include "LCD4Pico.hpp"
 
 namespace lcd4pico
 {
-    template <const Bit_Mode bit_mode>
-    void LCD4Pico<bit_mode>::clearDisplay()
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::clearDisplay()
     {
-        this->writeMode();
+        LCD4PICO_PERF(LatencyTimer timer(this->perf, this->perf.clearDisplay));
+        Batch batch(*this);
+
+        if (buffered)
+        {
+            frame = blankCells();
+            cursorIndex = 0;
+            homePending = true;
+            if (!this->incrementsCursor) // the clear display sets the entry mode to increment, the buffer is drawn that way from now on
+                this->setEntryMode(this->shiftsOnEntry, true);
+            return;
+        }
+
         this->setRegister(INSTRUCTION_REGISTER);
 
         this->writeData(0x1);
-
-        if (this->writeOnlyMode)
-            sleep_ms(2);
+        shadow = blankCells();
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4Pico<bit_mode>::returnHome()
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::returnHome()
     {
-        this->writeMode();
+        LCD4PICO_PERF(LatencyTimer timer(this->perf, this->perf.returnHome));
+        Batch batch(*this);
+
         this->setRegister(INSTRUCTION_REGISTER);
 
         this->writeData(0x2);
-
-        if (this->writeOnlyMode)
-            sleep_ms(2);
+        cursorIndex = 0;
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4Pico<bit_mode>::shiftDisplay(Direction direction)
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::shiftDisplay(Direction direction)
     {
-        this->writeMode();
+        Batch batch(*this);
+
         this->setRegister(INSTRUCTION_REGISTER);
 
         this->shiftDisplayOrCursor(direction, true);
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4Pico<bit_mode>::moveCursor(Direction direction)
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::moveCursor(Direction direction)
     {
-        this->writeMode();
+        Batch batch(*this);
+
+        if (buffered)
+        {
+            if (direction == Direction::Right)
+                cursorIndex = (cursorIndex + 1) % DDRAM_SIZE;
+            else if (direction == Direction::Left)
+                cursorIndex = (cursorIndex + DDRAM_SIZE - 1) % DDRAM_SIZE;
+            return;
+        }
+
         this->setRegister(INSTRUCTION_REGISTER);
 
         this->shiftDisplayOrCursor(direction, false);
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4Pico<bit_mode>::moveCursorTo(uint8_t displayPosition)
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::moveCursorTo(uint8_t displayPosition)
     {
+        Batch batch(*this);
+
+        if (buffered)
+        {
+            cursorIndex = toBufferIndex(displayPosition);
+            return;
+        }
+
         this->setDDRAM(displayPosition);
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4Pico<bit_mode>::toFirstLine()
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::setCursor(uint8_t row, uint8_t column)
     {
-        this->setDDRAM(0);
+        if (row >= Geometry::ROWS || column >= Geometry::COLUMNS)
+            return;
+
+        moveCursorTo(Geometry::address(row, column) + pageColumn());
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4Pico<bit_mode>::toSecondLine()
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::selectPage(uint8_t page)
     {
-        this->setDDRAM(0x40);
+        if (page >= PAGES)
+            return;
+
+        drawingPage = page;
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4Pico<bit_mode>::write(std::string str)
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    uint8_t LCD4Pico<bit_mode, Transport, Geometry>::selectedPage() const
     {
-        this->writeMode();
-        this->setRegister(DATA_REGISTER);
+        return drawingPage;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::showPage(uint8_t page)
+    {
+        if (page >= PAGES)
+            return;
+
+        Batch batch(*this);
+
+        if (!this->shiftKnown)
+            returnHome();
 
-        for (auto s : str)
+        // the display shift wraps around after a DDRAM line, shift in the shorter direction
+        uint8_t length = this->lineLength();
+        uint8_t left = (page * Geometry::COLUMNS + length - this->displayShift) % length;
+        if (left <= length / 2)
         {
-            this->writeData(s);
+            for (; left; left--)
+                shiftDisplay(Direction::Left);
         }
+        else
+        {
+            for (uint8_t right = length - left; right; right--)
+                shiftDisplay(Direction::Right);
+        }
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    uint8_t LCD4Pico<bit_mode, Transport, Geometry>::visiblePage() const
+    {
+        if (!this->shiftKnown || this->displayShift % Geometry::COLUMNS || this->displayShift / Geometry::COLUMNS >= PAGES)
+            return NO_PAGE;
+        return this->displayShift / Geometry::COLUMNS;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::clearPage()
+    {
+        Batch batch(*this);
+
+        for (uint8_t row = 0; row < Geometry::ROWS; row++)
+            writeRow(row, "");
+        setCursor(0, 0);
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    uint8_t LCD4Pico<bit_mode, Transport, Geometry>::pageColumn() const
+    {
+        return drawingPage * Geometry::COLUMNS;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::writeRow(uint8_t row, std::string_view text)
+    {
+        Batch batch(*this);
+
+        if (row >= Geometry::ROWS)
+            return;
+
+        bool wrap = lineWrap;
+        lineWrap = false;
+        setCursor(row, 0);
+        for (size_t column = writeText(text, Geometry::COLUMNS); column < Geometry::COLUMNS; column++)
+            writeCharacter(' ');
+        lineWrap = wrap;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::setLineWrap(bool enabled)
+    {
+        lineWrap = enabled;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::toFirstLine()
+    {
+        moveCursorTo(pageColumn());
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::toSecondLine()
+    {
+        moveCursorTo(SECOND_LINE_ADDRESS + pageColumn());
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::write(std::string_view str)
+    {
+        LCD4PICO_PERF(LatencyTimer timer(this->perf, this->perf.write));
+        Batch batch(*this);
+
+        writeText(str, SIZE_MAX);
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::write(const char *str, size_t length)
+    {
+        write(std::string_view(str, length));
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::setCharset(Charset charset, uint8_t replacement)
+    {
+        characterSet = charset;
+        replacementCode = replacement;
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4Pico<bit_mode>::writeLines(std::string firstLine, std::string secondLine)
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    Charset LCD4Pico<bit_mode, Transport, Geometry>::selectedCharset() const
     {
+        return characterSet;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::writeLines(std::string_view firstLine, std::string_view secondLine)
+    {
+        Batch batch(*this);
+
         toFirstLine();
         write(firstLine);
         toSecondLine();
         write(secondLine);
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4Pico<bit_mode>::createCustomCharacter(uint8_t index, const uint8_t (&character)[8])
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::writeNumber(int32_t value, uint8_t width, char fill)
+    {
+        char text[12];
+        auto result = std::to_chars(text, text + sizeof(text), value);
+        writeField(std::string_view(text, result.ptr - text), width, fill);
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::writeFixed(int32_t value, uint8_t decimals, uint8_t width, char fill)
+    {
+        if (decimals > 9)
+            return;
+
+        uint32_t magnitude = value < 0 ? 0u - (uint32_t)value : value;
+        char raw[10];
+        auto result = std::to_chars(raw, raw + sizeof(raw), magnitude);
+        uint8_t rawLength = result.ptr - raw;
+
+        // pad with zeros, so that there is at least one digit before the point
+        char digits[20];
+        uint8_t length = 0;
+        for (uint8_t zeros = rawLength; zeros <= decimals; zeros++)
+            digits[length++] = '0';
+        for (uint8_t i = 0; i < rawLength; i++)
+            digits[length++] = raw[i];
+
+        char text[24];
+        uint8_t n = 0;
+        if (value < 0)
+            text[n++] = '-';
+        for (uint8_t i = 0; i < length; i++)
+        {
+            if (decimals && i == length - decimals)
+                text[n++] = '.';
+            text[n++] = digits[i];
+        }
+
+        writeField(std::string_view(text, n), width, fill);
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::writeHex(uint32_t value, uint8_t digits)
+    {
+        char text[8];
+        auto result = std::to_chars(text, text + sizeof(text), value, 16);
+        uint8_t length = result.ptr - text;
+        for (uint8_t i = 0; i < length; i++)
+        {
+            if (text[i] >= 'a')
+                text[i] -= 'a' - 'A';
+        }
+        writeField(std::string_view(text, length), digits, '0');
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::writeField(std::string_view text, uint8_t width, char fill)
     {
+        if (width == 0)
+        {
+            write(text);
+            return;
+        }
+
+        // the field is built on the stack and written in one go
+        char field[UINT8_MAX];
+        uint8_t length = 0;
+        if (text.size() > width)
+        {
+            for (; length < width; length++)
+                field[length] = '#';
+        }
+        else
+        {
+            if (fill == '0' && !text.empty() && text[0] == '-')
+            {
+                field[length++] = '-';
+                text.remove_prefix(1);
+            }
+            while (length + text.size() < width)
+                field[length++] = fill;
+            for (auto character : text)
+                field[length++] = character;
+        }
+        write(std::string_view(field, length));
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    template <const size_t capacity>
+    void LCD4Pico<bit_mode, Transport, Geometry>::play(const Sequence<capacity> &sequence)
+    {
+        Batch batch(*this);
+
+        for (size_t i = 0; i < sequence.length; i++)
+        {
+            uint16_t operation = sequence.operations[i];
+            uint8_t data = operation & 0xFF;
+
+            if (operation & Sequence<capacity>::DATA)
+                writeCustomCharacter(data); // writes any character code
+            else if (data & SET_DDRAM)
+                moveCursorTo(data & ADDRESS_COUNTER);
+            else if (data == 0x1)
+                clearDisplay();
+            else if (data == 0x2 || data == 0x3)
+                returnHome();
+            else
+            {
+                this->setRegister(INSTRUCTION_REGISTER);
+                this->writeData(data);
+            }
+        }
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::createCustomCharacter(uint8_t index, const uint8_t (&character)[8])
+    {
+        LCD4PICO_PERF(LatencyTimer timer(this->perf, this->perf.createCustomCharacter));
+        Batch batch(*this);
+
         if (index > 7)
             return;
 
+        uploadGlyph(index, character);
+        glyphs.assign(index, GlyphCache::key(character));
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::uploadGlyph(uint8_t index, const uint8_t (&character)[8])
+    {
+        bool restoreAddress = this->addressKnown && !this->addressInCGRAM;
+        uint8_t cursorAddress = this->addressCounter;
+
+        // the rows are written top down, the display shift doesn't apply to CGRAM writes
+        bool decrements = !this->incrementsCursor;
+        if (decrements)
+            this->setEntryMode(this->shiftsOnEntry, true);
+
         this->setCGRAM(0x40 + (index * 8));
         this->setRegister(DATA_REGISTER);
 
@@ -99,13 +375,351 @@ namespace lcd4pico
             this->writeData(c);
         }
 
-        this->setDDRAM(0); // restore
+        this->setDDRAM(restoreAddress ? cursorAddress : 0); // restore
+        if (decrements)
+            this->setEntryMode(this->shiftsOnEntry, false);
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::writeCustomCharacter(uint8_t index)
+    {
+        Batch batch(*this);
+
+        if (buffered)
+        {
+            drawCharacter(index);
+            return;
+        }
+
+        this->setRegister(DATA_REGISTER);
+        sendCharacter(index);
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    bool LCD4Pico<bit_mode, Transport, Geometry>::loadGlyph(const uint8_t (&glyph)[8], uint8_t &code)
+    {
+        Batch batch(*this);
+
+        uint64_t key = GlyphCache::key(glyph);
+        uint8_t slot = glyphs.find(key);
+        if (slot == GlyphCache::NO_SLOT)
+        {
+            slot = glyphs.allocate(key, visibleGlyphSlots());
+            if (slot == GlyphCache::NO_SLOT)
+                return false;
+            uploadGlyph(slot, glyph);
+        }
+
+        code = slot;
+        return true;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    bool LCD4Pico<bit_mode, Transport, Geometry>::writeGlyph(const uint8_t (&glyph)[8])
+    {
+        Batch batch(*this);
+
+        uint8_t code = ' ';
+        bool loaded = loadGlyph(glyph, code);
+        writeCustomCharacter(code);
+        return loaded;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    bool LCD4Pico<bit_mode, Transport, Geometry>::pinGlyph(const uint8_t (&glyph)[8], bool pinned)
+    {
+        uint8_t code;
+        if (!loadGlyph(glyph, code))
+            return false;
+
+        glyphs.pin(code, pinned);
+        return true;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    bool LCD4Pico<bit_mode, Transport, Geometry>::snapshot(ScreenSnapshot &snapshot)
+    {
+        Batch batch(*this);
+
+        return this->readDDRAM(snapshot.ddram) && this->readCGRAM(snapshot.cgram);
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::restore(const ScreenSnapshot &snapshot)
+    {
+        Batch batch(*this);
+
+        this->writeCGRAM(snapshot.cgram);
+        this->writeDDRAM(snapshot.ddram);
+
+        for (uint8_t slot = 0; slot < CGRAM_SLOTS; slot++)
+        {
+            uint8_t glyph[8];
+            for (uint8_t row = 0; row < 8; row++)
+                glyph[row] = snapshot.cgram[slot * 8 + row] & 0x1F;
+            glyphs.assign(slot, GlyphCache::key(glyph));
+        }
+
+        for (uint8_t index = 0; index < DDRAM_SIZE; index++)
+            frame[index] = shadow[index] = snapshot.ddram[index];
+        shadowValid = true;
+        flushCount = 0;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    bool LCD4Pico<bit_mode, Transport, Geometry>::verify(const ScreenSnapshot &snapshot)
+    {
+        ScreenSnapshot current;
+        if (!this->snapshot(current))
+            return false;
+
+        for (uint8_t index = 0; index < DDRAM_SIZE; index++)
+        {
+            if (current.ddram[index] != snapshot.ddram[index])
+                return false;
+        }
+        for (uint8_t index = 0; index < CGRAM_SIZE; index++)
+        {
+            if ((current.cgram[index] ^ snapshot.cgram[index]) & 0x1F)
+                return false;
+        }
+        return true;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::setBuffered(bool enabled)
+    {
+        if (enabled == buffered)
+            return;
+
+        if (!enabled)
+        {
+            flush();
+            buffered = false;
+            return;
+        }
+
+        // the current content of the display is unknown, so the first flush sends every cell
+        frame = blankCells();
+        shadowValid = false;
+        cursorIndex = 0;
+        buffered = true;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::flush()
+    {
+        Batch batch(*this);
+
+        while (flushStep())
+        {
+        }
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    bool LCD4Pico<bit_mode, Transport, Geometry>::flushStep()
+    {
+        if (!buffered)
+            return false;
+
+        if (homePending)
+        {
+            // a clear display resets the display shift, the buffered one does it with the next flush
+            homePending = false;
+            if (!this->shiftKnown || this->displayShift)
+            {
+                this->setRegister(INSTRUCTION_REGISTER);
+                this->writeData(0x2);
+                return true;
+            }
+        }
+
+        // walk the buffer in the direction the address counter moves, so that runs need no jumps
+        for (; flushCount < DDRAM_SIZE; flushCount++)
+        {
+            uint8_t index = this->incrementsCursor ? flushCount : DDRAM_SIZE - 1 - flushCount;
+            if (shadowValid && frame[index] == shadow[index])
+                continue;
+
+            if (this->shiftsOnEntry)
+            {
+                // the cells are written in place, the display must not shift with every one of them
+                this->setEntryMode(false, this->incrementsCursor);
+                entryShiftSuspended = true;
+                return true;
+            }
+
+            uint8_t current = busIndex();
+            if (current != index)
+            {
+                // resending one unchanged cell costs as much as a jump, but keeps the run going
+                if (current != NO_INDEX && nextIndex(current) == index)
+                    sendCell(current);
+                else
+                    this->setDDRAM(toDDRAMAddress(index));
+                return true;
+            }
+            sendCell(index);
+            flushCount++;
+            return true;
+        }
+        if (entryShiftSuspended)
+        {
+            this->setEntryMode(true, this->incrementsCursor);
+            entryShiftSuspended = false;
+            return true;
+        }
+        shadowValid = true;
+        flushCount = 0;
+
+        this->setDDRAM(toDDRAMAddress(cursorIndex)); // leave the cursor where the application put it
+        return false;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::wrapCursor(uint8_t writtenAddress)
+    {
+        uint8_t row = 0, column = 0;
+        if (!Geometry::locate(writtenAddress - pageColumn(), row, column))
+            return;
+
+        if (this->incrementsCursor && column == Geometry::COLUMNS - 1)
+            setCursor((row + 1) % Geometry::ROWS, 0);
+        else if (!this->incrementsCursor && column == 0)
+            setCursor((row + Geometry::ROWS - 1) % Geometry::ROWS, Geometry::COLUMNS - 1);
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    uint8_t LCD4Pico<bit_mode, Transport, Geometry>::toBufferIndex(uint8_t ddramAddress) const
+    {
+        // in 1 line mode the DDRAM is one line of 80 cells at 0x00-0x4F
+        if (!this->twoLineMode)
+            return ddramAddress % DDRAM_SIZE;
+
+        uint8_t line = ddramAddress & SECOND_LINE_ADDRESS ? DDRAM_LINE_LENGTH : 0;
+        return line + (ddramAddress & ~SECOND_LINE_ADDRESS) % DDRAM_LINE_LENGTH;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    uint8_t LCD4Pico<bit_mode, Transport, Geometry>::toDDRAMAddress(uint8_t index) const
+    {
+        if (!this->twoLineMode || index < DDRAM_LINE_LENGTH)
+            return index;
+        return SECOND_LINE_ADDRESS + index - DDRAM_LINE_LENGTH;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    uint8_t LCD4Pico<bit_mode, Transport, Geometry>::busIndex() const
+    {
+        if (!this->addressKnown || this->addressInCGRAM)
+            return NO_INDEX;
+        return toBufferIndex(this->addressCounter);
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    uint8_t LCD4Pico<bit_mode, Transport, Geometry>::nextIndex(uint8_t index) const
+    {
+        // the address counter continues on the other line after the end of a line, just like the buffer index
+        if (this->incrementsCursor)
+            return (index + 1) % DDRAM_SIZE;
+        return (index + DDRAM_SIZE - 1) % DDRAM_SIZE;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::drawCharacter(uint8_t character)
+    {
+        frame[cursorIndex] = character;
+        cursorIndex = nextIndex(cursorIndex);
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4Pico<bit_mode>::writeCustomCharacter(uint8_t index)
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::writeCharacter(uint8_t character)
     {
+        if (buffered)
+        {
+            uint8_t address = toDDRAMAddress(cursorIndex);
+            drawCharacter(character);
+            if (lineWrap)
+                wrapCursor(address);
+            return;
+        }
+
+        uint8_t address = this->addressKnown && !this->addressInCGRAM ? this->addressCounter : UINT8_MAX;
         this->setRegister(DATA_REGISTER);
-        this->writeData(index);
+        sendCharacter(character);
+        if (lineWrap)
+            wrapCursor(address);
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    size_t LCD4Pico<bit_mode, Transport, Geometry>::writeText(std::string_view text, size_t maxCells)
+    {
+        if (characterSet == Charset::Raw)
+        {
+            text = text.substr(0, maxCells);
+            for (auto character : text)
+                writeCharacter(character);
+            return text.size();
+        }
+
+        size_t cells = 0;
+        for (size_t index = 0; index < text.size() && cells < maxCells;)
+        {
+            char32_t codePoint = charset::decodeUtf8(text, index);
+            uint8_t codes[2];
+            uint8_t count = charset::toROM(characterSet, codePoint, codes);
+            if (!count)
+            {
+                codes[0] = fallbackCode(codePoint);
+                count = 1;
+            }
+
+            for (uint8_t i = 0; i < count && cells < maxCells; i++, cells++)
+                writeCharacter(codes[i]);
+        }
+        return cells;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    uint8_t LCD4Pico<bit_mode, Transport, Geometry>::fallbackCode(char32_t codePoint)
+    {
+        const charset::Glyph *glyph = charset::findGlyph(codePoint);
+        uint8_t code;
+        if (glyph && loadGlyph(glyph->pattern, code))
+            return code;
+        return replacementCode;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::sendCell(uint8_t index)
+    {
+        this->setRegister(DATA_REGISTER);
+        this->writeData(frame[index]);
+        shadow[index] = frame[index];
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    void LCD4Pico<bit_mode, Transport, Geometry>::sendCharacter(uint8_t character)
+    {
+        uint8_t index = busIndex();
+        if (index != NO_INDEX)
+            shadow[index] = character; // remember the content for the glyph cache
+
+        this->writeData(character);
+    }
+
+    template <const Bit_Mode bit_mode, class Transport, class Geometry>
+    uint8_t LCD4Pico<bit_mode, Transport, Geometry>::visibleGlyphSlots() const
+    {
+        // character codes 0-15 show the CGRAM slots (8-15 mirror 0-7)
+        uint8_t slots = 0;
+        for (uint8_t index = 0; index < DDRAM_SIZE; index++)
+        {
+            if (shadow[index] < 16)
+                slots |= 1 << (shadow[index] & 7);
+            if (buffered && frame[index] < 16)
+                slots |= 1 << (frame[index] & 7);
+        }
+        return slots;
     }
 }
@@ -1,21 +1,57 @@
 #pragma once
 #include "pico/stdlib.h"
 #include <string>
+#include <string_view>
+#include <array>
 #include "LCD4PicoBase/LCD4PicoBase.hpp"
+#include "Geometry.hpp"
+#include "GlyphCache/GlyphCache.hpp"
+#include "Sequence/Sequence.hpp"
+#include "Charset/Charset.hpp"
 
 namespace lcd4pico
 {
-    template <const Bit_Mode bit_mode>
-    class LCD4Pico : private LCD4PicoBase<bit_mode>
+    /**
+     * @tparam Geometry Size of the display, e.g. `Geometry20x4` (default `Geometry16x2`).
+     */
+    template <const Bit_Mode bit_mode, class Transport = BitBangTransport<bit_mode>, class Geometry = Geometry16x2>
+    class LCD4Pico : private LCD4PicoBase<bit_mode, Transport>
     {
     public:
-        using LCD4PicoBase<bit_mode>::LCD4PicoBase;
-        using LCD4PicoBase<bit_mode>::setup;
-        using LCD4PicoBase<bit_mode>::setEntryMode;
-        using LCD4PicoBase<bit_mode>::displayControl;
+        using LCD4PicoBase<bit_mode, Transport>::LCD4PicoBase;
+        using LCD4PicoBase<bit_mode, Transport>::setup;
+        using LCD4PicoBase<bit_mode, Transport>::setEntryMode;
+        using LCD4PicoBase<bit_mode, Transport>::displayControl;
+        using LCD4PicoBase<bit_mode, Transport>::lineLength;
+        using LCD4PicoBase<bit_mode, Transport>::readyAt;
+        using LCD4PicoBase<bit_mode, Transport>::waitUntilReady;
+        using LCD4PicoBase<bit_mode, Transport>::transport;
+        using LCD4PicoBase<bit_mode, Transport>::calibrate;
+        using LCD4PicoBase<bit_mode, Transport>::setTimingProfile;
+        using LCD4PicoBase<bit_mode, Transport>::timingProfile;
+#ifdef LCD4PICO_PERF_COUNTERS
+        using LCD4PicoBase<bit_mode, Transport>::perfCounters;
+        using LCD4PicoBase<bit_mode, Transport>::resetPerfCounters;
+#endif
+#ifdef LCD4PICO_TRACE
+        using LCD4PicoBase<bit_mode, Transport>::setTrace;
+#endif
+
+        using DisplayGeometry = Geometry;
+
+        /**
+         * @brief Number of pages (screens of `Geometry::COLUMNS` columns) that fit side by side into the DDRAM lines,
+         *        e.g. 2 on a 16x2 display. Only displays with up to 2 rows have more than one page;
+         *        in 1 line mode the pages use the first 40 characters of the 80 character line.
+         *
+         */
+        static constexpr uint8_t PAGES = Geometry::ROWS <= 2 ? DDRAM_LINE_LENGTH / Geometry::COLUMNS : 1;
+        static constexpr uint8_t NO_PAGE = UINT8_MAX;
 
         /**
          * @brief Clears entire display and moves the cursor to the head of the first line.
+         *        Like the instruction it sets the entry mode to increment; in buffered mode that entry mode set
+         *        is sent right away, the cleared cells with the next flush.
          *
          */
         void clearDisplay();
@@ -41,28 +77,97 @@ namespace lcd4pico
         /**
          * @brief Moves the cursor to a specific position on the display.
          *
-         * @param displayPosition Position on the display, e.g. 0-15 for the first line, 64-79 for the second line.
+         * @param displayPosition DDRAM address, e.g. 0-15 for the first line, 64-79 for the second line of a 16x2 display.
          */
         void moveCursorTo(uint8_t displayPosition);
 
         /**
-         * @brief Moves the cursor to the head of the first line.
+         * @brief Moves the cursor to a row and column of the selected page (see `Geometry`, `selectPage`),
+         *        positions outside the display are ignored.
+         *
+         */
+        void setCursor(uint8_t row, uint8_t column);
+
+        /**
+         * @brief Selects the page `setCursor`, `writeRow`, `writeLines`, `toFirstLine`, `toSecondLine` and `clearPage` draw on.
+         *        A page can be drawn while another one is shown, e.g. in buffered mode in idle time.
+         *        `moveCursorTo` still takes DDRAM addresses.
+         *
+         * @param page 0 to `PAGES` - 1, page 0 is shown after `clearDisplay` and `returnHome`.
+         */
+        void selectPage(uint8_t page);
+
+        uint8_t selectedPage() const;
+
+        /**
+         * @brief Shows a page by shifting the display: one shift instruction per column between the pages,
+         *        in the shorter direction (16 instructions on a 16x2 display), the DDRAM is not written.
+         *
+         */
+        void showPage(uint8_t page);
+
+        /**
+         * @brief The page that is shown, `NO_PAGE` if the display is shifted to a position between the pages or
+         *        the shift is not known yet.
+         *
+         */
+        uint8_t visiblePage() const;
+
+        /**
+         * @brief Fills the selected page with spaces and moves the cursor to its head, the other pages are kept
+         *        (unlike `clearDisplay`).
+         *
+         */
+        void clearPage();
+
+        /**
+         * @brief Writes `text` to a whole row: it's cut at the end of the row and the rest of the row is filled with spaces.
+         *
+         */
+        void writeRow(uint8_t row, std::string_view text);
+
+        /**
+         * @brief If enabled, `write` continues on the next row of the display (in display order, i.e. the last row is
+         *        followed by the first one) instead of running into the DDRAM that is not visible.
+         *
+         */
+        void setLineWrap(bool enabled);
+
+        /**
+         * @brief Moves the cursor to the head of the first line of the selected page.
          *
          */
         void toFirstLine();
 
         /**
-         * @brief Moves the cursor to the head of the second line.
+         * @brief Moves the cursor to the head of the second line of the selected page.
          *
          */
         void toSecondLine();
 
         /**
-         * @brief Writes a string to the display.
+         * @brief Selects how `write`, `writeRow` and `writeLines` encode text. With `A00` or `A02` (the character ROM
+         *        of the display) the text is decoded as UTF-8 and mapped to the ROM, characters the ROM doesn't have are
+         *        drawn with a glyph from `charset::GLYPHS` if there is one and a CGRAM slot is free, otherwise `replacement`
+         *        is written. Codes below 0x20 are kept, e.g. for custom characters. `Raw` (default) sends the bytes as they are.
+         *
+         */
+        void setCharset(Charset charset, uint8_t replacement = '?');
+
+        Charset selectedCharset() const;
+
+        /**
+         * @brief Writes a string to the display. Accepts string literals, `std::string` and character arrays without copying them.
          *
-         * @param str ASCII string
+         * @param str ASCII string, UTF-8 if a charset is selected (`setCharset`)
          */
-        void write(std::string str);
+        void write(std::string_view str);
+
+        /**
+         * @brief Writes `length` characters from `str` to the display.
+         *
+         */
+        void write(const char *str, size_t length);
 
         /**
          * @brief Moves the cursor to the head of the first line and writes the `firstLine` to the display,
@@ -71,10 +176,44 @@ namespace lcd4pico
          * @param firstLine String to be displayed on the first line of the display.
          * @param secondLine String to be displayed on the second line of the display.
          */
-        void writeLines(std::string firstLine, std::string secondLine);
+        void writeLines(std::string_view firstLine, std::string_view secondLine);
+
+        /**
+         * @brief Writes an integer, right-aligned in a field of `width` characters.
+         *        If the number doesn't fit into the field, the field is filled with '#'.
+         *
+         * @param width Field width, 0 writes just the digits.
+         * @param fill Padding character, e.g. ' ' or '0' (zeros are put after the sign).
+         */
+        void writeNumber(int32_t value, uint8_t width = 0, char fill = ' ');
+
+        /**
+         * @brief Writes a fixed-point number, e.g. `writeFixed(-215, 1)` writes "-21.5".
+         *
+         * @param value The number multiplied by 10^decimals.
+         * @param decimals Digits after the decimal point (up to 9).
+         * @param width Field width (right-aligned, see `writeNumber`), 0 writes just the number.
+         */
+        void writeFixed(int32_t value, uint8_t decimals, uint8_t width = 0, char fill = ' ');
 
         /**
-         * @brief Create a Custom Character.
+         * @brief Writes a number as upper-case hex digits, padded with zeros to `digits` digits.
+         *        If the number has more digits, the field is filled with '#' (see `writeNumber`).
+         *
+         * @param digits Field width, 0 writes just the digits.
+         */
+        void writeHex(uint32_t value, uint8_t digits = 0);
+
+        /**
+         * @brief Plays a pre-encoded sequence, e.g. a static screen. Jumps to the address the cursor is already at are skipped,
+         *        in buffered mode the characters are drawn into the buffer.
+         *
+         */
+        template <const size_t capacity>
+        void play(const Sequence<capacity> &sequence);
+
+        /**
+         * @brief Create a Custom Character. The cursor stays where it was.
          *
          * @param index At which index should the character be saved. Indices from 0 to 7 are available.
          * @param character An array of 8 of 5 bits each that represents a character pattern (5x8).
@@ -87,6 +226,123 @@ namespace lcd4pico
          * @param index Index used to save the character with the `createCustomCharacter` method.
          */
         void writeCustomCharacter(uint8_t index);
+
+        /**
+         * @brief Makes sure a glyph is stored in the CGRAM and returns its character code.
+         *        Glyphs with the same pattern share one slot, the pattern is only uploaded if it isn't stored yet.
+         *        If all 8 slots are taken, the least recently used glyph that isn't pinned and isn't on the display is replaced.
+         *
+         * @param glyph An array of 8 of 5 bits each, e.g. from `lcd4pico::symbols`.
+         * @param code Character code (0-7) to be used with `writeCustomCharacter`.
+         * @return false if no slot could be freed, `code` is not changed then.
+         */
+        bool loadGlyph(const uint8_t (&glyph)[8], uint8_t &code);
+
+        /**
+         * @brief Loads a glyph (see `loadGlyph`) and writes it to the display.
+         *
+         * @return false if no slot could be freed, a space is written instead.
+         */
+        bool writeGlyph(const uint8_t (&glyph)[8]);
+
+        /**
+         * @brief Loads a glyph and keeps it in the CGRAM until it's unpinned, e.g. for icons that are used on every screen.
+         *
+         * @return false if no slot could be freed.
+         */
+        bool pinGlyph(const uint8_t (&glyph)[8], bool pinned = true);
+
+        /**
+         * @brief Reads the DDRAM and the custom characters in one pass each (144 reads, about 6 ms), e.g. to check or restore
+         *        the screen after a brown-out. The cursor is put back.
+         *
+         * @return false if the display can't be read (write only mode).
+         */
+        bool snapshot(ScreenSnapshot &snapshot);
+
+        /**
+         * @brief Writes a snapshot back to the display. The buffer (in buffered mode) and the glyph cache take over its content.
+         *
+         */
+        void restore(const ScreenSnapshot &snapshot);
+
+        /**
+         * @brief Reads the display memory and compares it to `snapshot` (only the pattern bits of the custom characters).
+         *
+         * @return false if it differs or the display can't be read.
+         */
+        bool verify(const ScreenSnapshot &snapshot);
+
+        /**
+         * @brief Enables or disables the buffered mode.
+         *        In buffered mode `write`, `writeLines`, `writeCustomCharacter`, `clearDisplay` and the cursor methods
+         *        only draw into an in-RAM copy of the DDRAM, nothing is sent to the display until `flush` is called.
+         *        Disabling the buffered mode flushes all pending changes.
+         *
+         * @param enabled true to draw into the buffer, false to write straight to the display (default).
+         */
+        void setBuffered(bool enabled);
+
+        /**
+         * @brief Sends only the cells that changed since the last flush to the display (buffered mode only).
+         *        Neighbouring changes are sent as one run, the cursor is only moved between runs.
+         *        If the entry mode shifts the display, the shift is switched off while the cells are sent.
+         *        After a `clearDisplay` the display shift is reset first, like the unbuffered clear does.
+         *
+         */
+        void flush();
+
+        /**
+         * @brief Does one transfer of a flush (a cell or a cursor jump), so that a flush can be spread over time
+         *        or interleaved with other displays. Call it again as long as it returns true.
+         *
+         * @return true if there's more to send.
+         */
+        bool flushStep();
+
+    private:
+        using typename LCD4PicoBase<bit_mode, Transport>::Batch;
+
+        static constexpr uint8_t NO_INDEX = UINT8_MAX;
+
+        bool buffered = false;
+        bool shadowValid = false;         // false until the whole buffer was sent once
+        uint8_t flushCount = 0;           // cells checked by the current flush
+        bool entryShiftSuspended = false; // the flush switched the display shift on entry off
+        bool homePending = false;         // clearDisplay in buffered mode, the next flush resets the display shift
+        bool lineWrap = false;
+        uint8_t drawingPage = 0;
+        Charset characterSet = Charset::Raw;
+        uint8_t replacementCode = '?';
+        uint8_t cursorIndex = 0;          // buffer index the next character is drawn to
+        std::array<uint8_t, DDRAM_SIZE> frame = blankCells();  // what should be on the display
+        std::array<uint8_t, DDRAM_SIZE> shadow = blankCells(); // what was last sent to the display
+
+        GlyphCache glyphs;
+
+        static constexpr std::array<uint8_t, DDRAM_SIZE> blankCells()
+        {
+            std::array<uint8_t, DDRAM_SIZE> cells = {};
+            for (auto &cell : cells)
+                cell = ' ';
+            return cells;
+        }
+
+        uint8_t toBufferIndex(uint8_t ddramAddress) const; // buffer index in the order the address counter steps through the DDRAM
+        uint8_t toDDRAMAddress(uint8_t index) const;
+        uint8_t pageColumn() const; // first DDRAM column of the selected page
+        uint8_t busIndex() const; // buffer index of the display's address counter, or NO_INDEX if unknown
+        uint8_t nextIndex(uint8_t index) const;
+        void drawCharacter(uint8_t character);
+        void writeCharacter(uint8_t character);
+        size_t writeText(std::string_view text, size_t maxCells); // returns the number of cells written
+        uint8_t fallbackCode(char32_t codePoint);
+        void sendCell(uint8_t index);
+        void writeField(std::string_view text, uint8_t width, char fill);
+        void wrapCursor(uint8_t writtenAddress);
+        void sendCharacter(uint8_t character);
+        void uploadGlyph(uint8_t index, const uint8_t (&character)[8]);
+        uint8_t visibleGlyphSlots() const;
     };
 }
 
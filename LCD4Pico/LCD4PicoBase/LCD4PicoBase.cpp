@@ -4,74 +4,75 @@
 
 namespace lcd4pico
 {
-    template <const Bit_Mode bit_mode>
-    LCD4PicoBase<bit_mode>::LCD4PicoBase(uint8_t Enable_Pin,
-                                         uint8_t RS_Pin,
-                                         uint8_t RW_Pin,
-                                         const uint8_t (&Data_Pins)[bit_mode]) :
+    template <const Bit_Mode bit_mode, class Transport>
+    LCD4PicoBase<bit_mode, Transport>::LCD4PicoBase(uint8_t Enable_Pin,
+                                                    uint8_t RS_Pin,
+                                                    uint8_t RW_Pin,
+                                                    const uint8_t (&Data_Pins)[bit_mode]) :
 
-                                                                                 ENABLEPIN(Enable_Pin),
-                                                                                 RSPIN(RS_Pin),
-                                                                                 RWPIN(RW_Pin),
-                                                                                 DATAPINS(Data_Pins)
+                                                                                            bus(Enable_Pin, RS_Pin, RW_Pin, Data_Pins)
     {
     }
 
-    template <const Bit_Mode bit_mode>
-    LCD4PicoBase<bit_mode>::LCD4PicoBase(uint8_t Enable_Pin,
-                                         uint8_t RS_Pin,
-                                         const uint8_t (&Data_Pins)[bit_mode]) :
+    template <const Bit_Mode bit_mode, class Transport>
+    LCD4PicoBase<bit_mode, Transport>::LCD4PicoBase(uint8_t Enable_Pin,
+                                                    uint8_t RS_Pin,
+                                                    const uint8_t (&Data_Pins)[bit_mode]) :
 
-                                                                                 ENABLEPIN(Enable_Pin),
-                                                                                 RSPIN(RS_Pin),
-                                                                                 RWPIN(WRITE_ONLY),
-                                                                                 DATAPINS(Data_Pins)
+                                                                                            bus(Enable_Pin, RS_Pin, Data_Pins)
     {
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4PicoBase<bit_mode>::setup(uint8_t numOfdisplayLines,
-                                       bool largeFont,
-                                       bool blinkingCursor,
-                                       bool cursorOn,
-                                       bool displayOn,
-                                       bool accompanyDisplayShift,
-                                       bool incrementCursor)
+    template <const Bit_Mode bit_mode, class Transport>
+    LCD4PicoBase<bit_mode, Transport>::LCD4PicoBase(const Transport &transport) : bus(transport)
     {
-        gpio_init(ENABLEPIN);
-        gpio_init(RSPIN);
-        if (RWPIN != WRITE_ONLY)
-        {
-            gpio_init(RWPIN);
-            gpio_set_dir(RWPIN, GPIO_OUT);
-            writeOnlyMode = false;
-        }
-        gpio_set_dir(ENABLEPIN, GPIO_OUT);
-        gpio_set_dir(RSPIN, GPIO_OUT);
-        setEnable(0);
+    }
+
+    template <const Bit_Mode bit_mode, class Transport>
+    bool LCD4PicoBase<bit_mode, Transport>::setup(uint8_t numOfdisplayLines,
+                                                  bool largeFont,
+                                                  bool blinkingCursor,
+                                                  bool cursorOn,
+                                                  bool displayOn,
+                                                  bool accompanyDisplayShift,
+                                                  bool incrementCursor)
+    {
+        Batch batch(*this);
+
+        bus.init();
+        writeOnlyMode = !bus.canRead();
         setRegister(INSTRUCTION_REGISTER);
 
+        // neither the probe nor the reset sequence may reach a display that is still in its power on reset
+        uint64_t now = bus.now();
+        if (now < POWER_ON_TIME)
+            bus.delay(POWER_ON_TIME - now);
+
+        bool warmStart = !writeOnlyMode && canProbe(bus, 0) && isConfigured();
+        if (!warmStart)
+            resetInterface();
+
         setFunctionMode(numOfdisplayLines, largeFont);
         displayControl(blinkingCursor, cursorOn, displayOn);
         setEntryMode(accompanyDisplayShift, incrementCursor);
+        if (!warmStart)
+            setDDRAM(0); // the probe of a display in the 8bit power on mode sets CGRAM addresses
+        return warmStart;
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4PicoBase<bit_mode>::setFunctionMode(uint8_t numDisplayLines, bool largeFont)
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::setFunctionMode(uint8_t numDisplayLines, bool largeFont)
     {
         if (isFunctionSet)
             return;
 
-        writeMode();
+        Batch batch(*this);
+
         setRegister(INSTRUCTION_REGISTER);
 
         uint8_t data = FUNCTION_SET;
         if (bit_mode == _8BIT)
             data |= _8BIT_MODE;
-        else
-        {
-            writeUpperNibble(data); // set operation mode to 4bit
-        }
 
         if (numDisplayLines == 2)
         {
@@ -85,13 +86,12 @@ namespace lcd4pico
         isFunctionSet = true;
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4PicoBase<bit_mode>::shiftDisplayOrCursor(Direction direction, bool display)
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::shiftDisplayOrCursor(Direction direction, bool display)
     {
         if (direction != Direction::Left && direction != Direction::Right)
             return;
 
-        writeMode();
         setRegister(INSTRUCTION_REGISTER);
 
         uint8_t data = direction == Direction::Right ? RIGHT_SHIFT : LEFT_SHIFT;
@@ -101,10 +101,11 @@ namespace lcd4pico
         writeData(data);
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4PicoBase<bit_mode>::setEntryMode(bool accompanyDisplayShift, bool incrementCursor)
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::setEntryMode(bool accompanyDisplayShift, bool incrementCursor)
     {
-        writeMode();
+        Batch batch(*this);
+
         setRegister(INSTRUCTION_REGISTER);
 
         uint8_t data = ENTRY_MODE_SET;
@@ -116,10 +117,11 @@ namespace lcd4pico
         writeData(data);
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4PicoBase<bit_mode>::displayControl(bool blinkingCursor, bool cursorOn, bool displayOn)
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::displayControl(bool blinkingCursor, bool cursorOn, bool displayOn)
     {
-        writeMode();
+        Batch batch(*this);
+
         setRegister(INSTRUCTION_REGISTER);
 
         uint8_t data = DISPLAY_CONTROL;
@@ -133,203 +135,540 @@ namespace lcd4pico
         writeData(data);
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4PicoBase<bit_mode>::setCGRAM(uint8_t addr)
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::setCGRAM(uint8_t addr)
     {
-        writeMode();
+        if (addressKnown && addressInCGRAM && addressCounter == (addr & (CGRAM_SIZE - 1)))
+            return;
+
         setRegister(INSTRUCTION_REGISTER);
 
         writeData(SET_CGRAM | addr);
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4PicoBase<bit_mode>::setDDRAM(uint8_t addr)
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::setDDRAM(uint8_t addr)
     {
-        writeMode();
+        if (addressKnown && !addressInCGRAM && addressCounter == (addr & ADDRESS_COUNTER))
+            return;
+
         setRegister(INSTRUCTION_REGISTER);
 
         writeData(SET_DDRAM | addr);
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4PicoBase<bit_mode>::readMode()
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::setRegister(bool reg)
     {
-        if (!isInWriteMode)
+        if (registerKnown && reg == registerSelect)
             return;
-        for (uint8_t pin : DATAPINS)
+
+        bus.setRegister(reg);
+        registerSelect = reg;
+        registerKnown = true;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport>
+    bool LCD4PicoBase<bit_mode, Transport>::isBusy()
+    {
+        if (writeOnlyMode)
+            return false;
+        setRegister(INSTRUCTION_REGISTER);
+
+        uint8_t data = readData();
+        bool bf = data & BUSY_FLAG; // extract the busy-flag
+        LCD4PICO_PERF(perf.busyFlagReads++);
+
+        return bf;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport>
+    bool LCD4PicoBase<bit_mode, Transport>::isBusy(uint8_t &addrCounter)
+    {
+        if (writeOnlyMode)
+            return false;
+        setRegister(INSTRUCTION_REGISTER);
+
+        uint8_t data = readData();
+        bool bf = data & BUSY_FLAG;           // extract the busy-flag
+        LCD4PICO_PERF(perf.busyFlagReads++);
+        addrCounter = data & ADDRESS_COUNTER; // extract address counter
+
+        return bf;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport>
+    uint8_t LCD4PicoBase<bit_mode, Transport>::readData()
+    {
+        if (writeOnlyMode)
+            return 0;
+
+        LCD4PICO_TRACED(uint64_t start_us = bus.now());
+        uint8_t data = bus.read();
+        LCD4PICO_TRACED(traceAccess(start_us, (registerSelect ? Trace::Data : 0) | Trace::Read, data));
+        LCD4PICO_PERF(countAccess(true, bit_mode == _4BIT ? 2 : 1));
+        if (registerSelect == DATA_REGISTER) // reading RAM moves the address counter too, that takes as long as a write
         {
-            gpio_init(pin);
-            gpio_set_dir(pin, GPIO_IN);
+            scheduleDeadline(DATA_REGISTER, data);
+            stepAddressCounter(incrementsCursor);
         }
-        gpio_put(RWPIN, 1);
-        isInWriteMode = false;
+        return data;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::writeData(uint8_t data)
+    {
+        Batch batch(*this);
+
+        waitWhileBusy();
+
+        LCD4PICO_TRACED(traceAccess(bus.now(), registerSelect ? Trace::Data : 0, data));
+        bus.write(data);
+        LCD4PICO_PERF(countAccess(false, bit_mode == _4BIT ? 2 : 1));
+        LCD4PICO_PERF(registerSelect == DATA_REGISTER ? perf.dataBytes++ : perf.instructions++);
+        LCD4PICO_PERF(countLongInstruction(registerSelect, data));
+        scheduleDeadline(registerSelect, data);
+        trackTransfer(registerSelect, data);
+    }
+
+    template <const Bit_Mode bit_mode, class Transport>
+    uint8_t LCD4PicoBase<bit_mode, Transport>::lineLength() const
+    {
+        return twoLineMode ? DDRAM_LINE_LENGTH : DDRAM_SIZE;
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4PicoBase<bit_mode>::writeMode()
+    template <const Bit_Mode bit_mode, class Transport>
+    uint64_t LCD4PicoBase<bit_mode, Transport>::readyAt() const
     {
-        if (isInWriteMode)
-            return; // don't switch to write mode if it's alreay in it
-        for (uint8_t pin : DATAPINS)
+        if (writeOnlyMode || !isFunctionSet)
+            return safeDeadline;
+        return nominalDeadline < safeDeadline ? nominalDeadline : safeDeadline;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::waitUntilReady()
+    {
+        if (!batchDepth)
+            bus.commit();
+        waitWhileBusy();
+    }
+
+    template <const Bit_Mode bit_mode, class Transport>
+    bool LCD4PicoBase<bit_mode, Transport>::calibrate(TimingProfile &profile, uint8_t margin_percent)
+    {
+        if (writeOnlyMode || !isFunctionSet)
+            return false;
+
+        uint32_t instruction = 0, dataWrite = 0, home = 0;
+        for (uint8_t round = 0; round < CALIBRATION_ROUNDS; round++)
         {
-            gpio_init(pin);
-            gpio_set_dir(pin, GPIO_OUT);
+            uint32_t time = measureExecutionTime(INSTRUCTION_REGISTER, SET_DDRAM);
+            instruction = time > instruction ? time : instruction;
+
+            // the cell at 0x00 is read and written back unchanged
+            setRegister(DATA_REGISTER);
+            uint8_t cell = readData();
+            setDDRAM(0);
+            time = measureExecutionTime(DATA_REGISTER, cell);
+            dataWrite = time > dataWrite ? time : dataWrite;
+
+            time = measureExecutionTime(INSTRUCTION_REGISTER, 0x2); // return home
+            home = time > home ? time : home;
         }
-        gpio_put(RWPIN, 0);
-        isInWriteMode = true;
+
+        profile.instruction_us = instruction * (100 + margin_percent) / 100 + 1;
+        profile.dataWrite_us = dataWrite * (100 + margin_percent) / 100 + 1;
+        profile.clearOrHome_us = home * (100 + margin_percent) / 100 + 1;
+        return true;
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4PicoBase<bit_mode>::pulseEnable(uint64_t pulseWidth_us)
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::setTimingProfile(const TimingProfile &profile)
     {
-        setEnable(1);
-        sleep_us(pulseWidth_us);
-        setEnable(0);
+        timing = profile;
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4PicoBase<bit_mode>::pulseEnable()
+    template <const Bit_Mode bit_mode, class Transport>
+    const TimingProfile &LCD4PicoBase<bit_mode, Transport>::timingProfile() const
     {
-        setEnable(1);
-        sleep_us(1);
-        setEnable(0);
+        return timing;
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4PicoBase<bit_mode>::setEnable(bool value)
+    template <const Bit_Mode bit_mode, class Transport>
+    uint32_t LCD4PicoBase<bit_mode, Transport>::measureExecutionTime(bool reg, uint8_t data)
     {
-        gpio_put(ENABLEPIN, value);
+        waitWhileBusy();
+        setRegister(reg);
+
+        LCD4PICO_TRACED(traceAccess(bus.now(), reg ? Trace::Data : 0, data));
+        bus.write(data);
+        uint64_t start = bus.now();
+        scheduleDeadline(reg, data);
+        trackTransfer(reg, data);
+
+        // the busy flag is sampled at the start of a read, so the transfer finished before the first read that wasn't busy
+        uint64_t end;
+        do
+        {
+            end = bus.now();
+        } while (isBusy());
+        safeDeadline = bus.now();
+
+        return end - start;
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4PicoBase<bit_mode>::setRegister(bool reg)
+    template <const Bit_Mode bit_mode, class Transport>
+    bool LCD4PicoBase<bit_mode, Transport>::readDDRAM(uint8_t (&cells)[DDRAM_SIZE])
     {
-        gpio_put(RSPIN, reg);
+        return transferRAM(false, cells, nullptr, DDRAM_SIZE);
     }
 
-    template <const Bit_Mode bit_mode>
-    bool LCD4PicoBase<bit_mode>::isBusy()
+    template <const Bit_Mode bit_mode, class Transport>
+    bool LCD4PicoBase<bit_mode, Transport>::readCGRAM(uint8_t (&patterns)[CGRAM_SIZE])
     {
-        if (writeOnlyMode)
-            return false;
-        setRegister(INSTRUCTION_REGISTER);
-        readMode();
+        return transferRAM(true, patterns, nullptr, CGRAM_SIZE);
+    }
 
-        uint8_t data = readData();
-        bool bf = data & BUSY_FLAG; // extract the busy-flag
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::writeDDRAM(const uint8_t (&cells)[DDRAM_SIZE])
+    {
+        transferRAM(false, nullptr, cells, DDRAM_SIZE);
+    }
 
-        return bf;
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::writeCGRAM(const uint8_t (&patterns)[CGRAM_SIZE])
+    {
+        transferRAM(true, nullptr, patterns, CGRAM_SIZE);
     }
 
-    template <const Bit_Mode bit_mode>
-    bool LCD4PicoBase<bit_mode>::isBusy(uint8_t &addrCounter)
+    template <const Bit_Mode bit_mode, class Transport>
+    bool LCD4PicoBase<bit_mode, Transport>::transferRAM(bool cgram, uint8_t *readInto, const uint8_t *writeFrom, uint8_t length)
     {
-        if (writeOnlyMode)
+        if (readInto && (writeOnlyMode || !isFunctionSet))
             return false;
+
+        Batch batch(*this);
+
+        if (!addressKnown && !writeOnlyMode) // the address counter can be read, but not whether it points into the CGRAM
+        {
+            waitWhileBusy();
+            uint8_t address;
+            isBusy(address);
+            addressCounter = address;
+            addressInCGRAM = false;
+            addressKnown = true;
+        }
+        bool restoreAddress = addressKnown;
+        bool restoreInCGRAM = addressInCGRAM;
+        uint8_t cursorAddress = addressCounter;
+
+        bool increment = incrementsCursor;
+        bool shift = shiftsOnEntry;
+        if (!increment || shift)
+            setEntryMode(false, true);
+
+        // the data of a read is fetched when the address is set, so the address is always sent before a read
         setRegister(INSTRUCTION_REGISTER);
+        writeData(cgram ? SET_CGRAM : SET_DDRAM);
+        setRegister(DATA_REGISTER);
+        for (uint8_t i = 0; i < length; i++)
+        {
+            if (readInto)
+            {
+                waitWhileBusy();
+                readInto[i] = readData();
+            }
+            else
+                writeData(writeFrom[i]);
+        }
 
-        uint8_t data = readData();
-        bool bf = data & BUSY_FLAG;           // extract the busy-flag
-        addrCounter = data & ADDRESS_COUNTER; // extract address counter
+        if (!increment || shift)
+            setEntryMode(shift, increment);
+        if (restoreAddress && restoreInCGRAM)
+            setCGRAM(cursorAddress);
+        else
+            setDDRAM(restoreAddress ? cursorAddress : 0);
+        return true;
+    }
 
-        return bf;
+    template <const Bit_Mode bit_mode, class Transport>
+    Transport &LCD4PicoBase<bit_mode, Transport>::transport()
+    {
+        return bus;
     }
 
-    template <const Bit_Mode bit_mode>
-    uint8_t LCD4PicoBase<bit_mode>::readData()
+#ifdef LCD4PICO_PERF_COUNTERS
+    template <const Bit_Mode bit_mode, class Transport>
+    PerfCounters LCD4PicoBase<bit_mode, Transport>::perfCounters() const
     {
-        if (writeOnlyMode)
-            return 0;
-        readMode();
+        return perf;
+    }
 
-        setEnable(1);
-        sleep_us(1);
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::resetPerfCounters()
+    {
+        perf = PerfCounters();
+        pendingLongInstruction = nullptr;
+    }
 
-        uint8_t data = 0;
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::countAccess(bool read, uint8_t strobes)
+    {
+        if (read != lastAccessWasRead)
+            perf.turnarounds++;
+        lastAccessWasRead = read;
+        perf.strobes += strobes;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::countLongInstruction(bool reg, uint8_t data)
+    {
+        pendingLongInstruction = nullptr;
+        if (reg == INSTRUCTION_REGISTER && data == 0x1)
+            pendingLongInstruction = &PerfCounters::clearDisplay;
+        else if (reg == INSTRUCTION_REGISTER && (data & 0xFE) == 0x2)
+            pendingLongInstruction = &PerfCounters::returnHome;
+    }
+#endif
+
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::waitWhileBusy()
+    {
+        LCD4PICO_PERF(Stopwatch stopwatch(perf.waitWhileBusy_us));
+        LCD4PICO_PERF(DeferredWait deferredWait(perf, pendingLongInstruction));
 
-        for (uint8_t pin = 0; pin < bit_mode; pin++)
+        uint64_t now = bus.now();
+        if (now >= safeDeadline)
+            return;
+
+        if (writeOnlyMode || !isFunctionSet) // the busy flag can't be used
         {
-            uint8_t bit = gpio_get(DATAPINS[pin]) ? 1 : 0;
-            data |= bit << pin;
+            LCD4PICO_PERF(Stopwatch delayStopwatch(perf.delay_us));
+            bus.delay(safeDeadline - now);
+            return;
         }
 
-        setEnable(0);
-        if (bit_mode == _4BIT)
+        if (now < nominalDeadline) // no point in polling yet
         {
-            sleep_us(1);
-            setEnable(1);
-            sleep_us(1);
-
-            data <<= 4;
-            for (uint8_t pin = 0; pin < bit_mode; pin++)
-            {
-                uint8_t bit = gpio_get(DATAPINS[pin]) ? 1 : 0;
-                data |= bit << pin;
-            }
+            LCD4PICO_PERF(Stopwatch delayStopwatch(perf.delay_us));
+            bus.delay(nominalDeadline - now);
+        }
 
-            setEnable(0);
+        bool state = registerSelect; // save the current state of the RS pin
+        while (isBusy())
+        {
+            bus.delay(1); // through the transport, so its clock and queue stay in step with the polling
+            bus.sync();
         }
-        return data;
+        setRegister(state); // reset the state
+        safeDeadline = bus.now();
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4PicoBase<bit_mode>::writeData(uint8_t data)
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::scheduleDeadline(bool reg, uint8_t data)
     {
-        if (!writeOnlyMode)
-            waitWhileBusy(); // use busy flag checking if it's available as it's more safer
+        bool clearOrHome = reg == INSTRUCTION_REGISTER && data && data <= 0x3;
+        uint64_t now = bus.now();
+
+        nominalDeadline = now + (clearOrHome ? LONG_EXECUTION_TIME : EXECUTION_TIME);
+        if (writeOnlyMode || !isFunctionSet)
+        {
+            if (clearOrHome)
+                safeDeadline = now + timing.clearOrHome_us;
+            else
+                safeDeadline = now + (reg == DATA_REGISTER ? timing.dataWrite_us : timing.instruction_us);
+        }
         else
-            sleep_us(INSTRUCTION_WAITING_TIME);
+            safeDeadline = now + (clearOrHome ? SAFE_LONG_EXECUTION_TIME : SAFE_EXECUTION_TIME);
+    }
 
-        writeMode();
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::trackTransfer(bool reg, uint8_t data)
+    {
+        if (reg == DATA_REGISTER)
+        {
+            if (shiftsOnEntry && !addressInCGRAM)
+                displayShift = (displayShift + (incrementsCursor ? 1 : lineLength() - 1)) % lineLength();
+            stepAddressCounter(incrementsCursor);
+            return;
+        }
 
-        for (uint8_t bit = bit_mode == _8BIT ? 1 : 16, pin = 0; pin < bit_mode; bit <<= 1, pin++)
+        if (data & SET_DDRAM)
+        {
+            addressCounter = data & ADDRESS_COUNTER;
+            addressInCGRAM = false;
+            addressKnown = true;
+        }
+        else if (data & SET_CGRAM)
+        {
+            addressCounter = data & (CGRAM_SIZE - 1);
+            addressInCGRAM = true;
+            addressKnown = true;
+        }
+        else if (data & FUNCTION_SET)
+            twoLineMode = data & TWO_DISPLAY_LINES;
+        else if (data & LEFT_SHIFT)
+        {
+            bool right = (data & RIGHT_SHIFT) == RIGHT_SHIFT;
+            if ((data & DISPLAY_SHIFT) == DISPLAY_SHIFT)
+                displayShift = (displayShift + (right ? lineLength() - 1 : 1)) % lineLength();
+            else
+                stepAddressCounter(right);
+        }
+        else if (data & DISPLAY_CONTROL)
+            return;
+        else if (data & ENTRY_MODE_SET)
+        {
+            incrementsCursor = data & INCREMENT_CURSOR;
+            shiftsOnEntry = data & ACCOMPANY_DISPLAY_SHIFT;
+        }
+        else if (data) // clear display or return home
         {
-            gpio_put(DATAPINS[pin], data & bit);
+            if (data == 0x1)
+                incrementsCursor = true; // clearing the display also sets the entry mode to increment
+            addressCounter = 0;
+            addressInCGRAM = false;
+            addressKnown = true;
+            displayShift = 0;
+            shiftKnown = true;
         }
+    }
 
-        pulseEnable();
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::stepAddressCounter(bool increment)
+    {
+        if (addressInCGRAM)
+        {
+            addressCounter = (addressCounter + (increment ? 1 : -1)) & (CGRAM_SIZE - 1);
+            return;
+        }
 
-        if (bit_mode == _4BIT)
+        if (!twoLineMode)
         {
-            for (uint8_t bit = 1, pin = 0; pin < bit_mode; bit <<= 1, pin++)
-            {
-                gpio_put(DATAPINS[pin], data & bit);
-            }
-            pulseEnable();
+            if (increment)
+                addressCounter = addressCounter >= DDRAM_SIZE - 1 ? 0 : addressCounter + 1;
+            else
+                addressCounter = addressCounter == 0 ? DDRAM_SIZE - 1 : addressCounter - 1;
+            return;
         }
+
+        // in 2 line mode the address counter continues on the other line after the end of a line
+        uint8_t line = addressCounter & SECOND_LINE_ADDRESS;
+        uint8_t column = addressCounter & ~SECOND_LINE_ADDRESS;
+        if (increment && column >= DDRAM_LINE_LENGTH - 1)
+            addressCounter = line ^ SECOND_LINE_ADDRESS;
+        else if (!increment && column == 0)
+            addressCounter = (line ^ SECOND_LINE_ADDRESS) + DDRAM_LINE_LENGTH - 1;
+        else
+            addressCounter += increment ? 1 : -1;
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4PicoBase<bit_mode>::waitWhileBusy()
+    template <const Bit_Mode bit_mode, class Transport>
+    bool LCD4PicoBase<bit_mode, Transport>::isConfigured()
     {
-        if (isFunctionSet)
+        uint8_t cursor, address;
+        if (!waitForBusyFlag(SAFE_LONG_EXECUTION_TIME, cursor))
+            return false;
+
+        // an interface that's still in the 8bit power on mode or half a byte out of step (4bit)
+        // doesn't report the probe addresses back. In 4bit mode the nibbles are sent apart,
+        // a display in 8bit mode executes each of them as an instruction
+        for (uint8_t probe : WARM_START_PROBES)
         {
-            bool state = gpio_get(RSPIN); // save the current state of the RS pin
-            while (isBusy())
+            writeResetInstruction(SET_DDRAM | probe);
+            if (bit_mode == _4BIT)
             {
-                sleep_us(1);
+                bus.delay(SAFE_EXECUTION_TIME);
+                writeResetInstruction((SET_DDRAM | probe) << 4);
             }
-            gpio_put(RSPIN, state); // reset the state
+            if (!waitForBusyFlag(SAFE_EXECUTION_TIME, address) || address != probe)
+                return false;
         }
-        else
-            sleep_us(INSTRUCTION_WAITING_TIME);
+
+        writeData(SET_DDRAM | cursor); // put the cursor back
+        return true;
     }
 
-    template <const Bit_Mode bit_mode>
-    void LCD4PicoBase<bit_mode>::writeUpperNibble(uint8_t data)
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::resetInterface()
     {
-        if (!writeOnlyMode)
-            waitWhileBusy();
-        else
-            sleep_us(INSTRUCTION_WAITING_TIME);
+        // like at the first setup, e.g. after a brown-out: the sequence ends in 1 line mode, the function set is sent again
+        isFunctionSet = false;
 
-        writeMode();
+        // a calibrated profile of a slow display (write only mode) may need longer than the datasheet
+        const uint16_t instructionTime = timing.instruction_us > SAFE_EXECUTION_TIME ? timing.instruction_us : SAFE_EXECUTION_TIME;
 
-        for (uint8_t bit = 16, pin = 0; pin < 4; bit <<= 1, pin++)
+        // initializing by instruction: the first function set may complete a byte the display was still waiting for,
+        // after the third one the interface is in 8bit mode, whatever mode and nibble phase it was in before
+        const uint16_t waitingTimes[] = {RESET_WAITING_TIME, SHORT_RESET_WAITING_TIME, instructionTime};
+        uint8_t address;
+        for (uint16_t waitingTime : waitingTimes)
+        {
+            writeResetInstruction(FUNCTION_SET | _8BIT_MODE);
+            waitForBusyFlag(waitingTime, address);
+        }
+
+        if (bit_mode == _4BIT)
         {
-            gpio_put(DATAPINS[pin], data & bit);
+            writeResetInstruction(FUNCTION_SET); // 4bit and in step from here on
+            waitForBusyFlag(instructionTime, address);
         }
 
-        pulseEnable();
+        // the probe may have moved the address counter and the display may have executed a half received instruction
+        addressKnown = false;
+        shiftKnown = false;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport>
+    bool LCD4PicoBase<bit_mode, Transport>::waitForBusyFlag(uint32_t limit_us, uint8_t &addrCounter)
+    {
+        uint64_t limit = bus.now() + limit_us;
+        addrCounter = 0;
+        if (!writeOnlyMode)
+        {
+            while (isBusy(addrCounter))
+            {
+                if (bus.now() >= limit)
+                    return false;
+            }
+            limit = bus.now();
+        }
+
+        // without the busy flag the next transfer waits for the whole time
+        nominalDeadline = limit;
+        safeDeadline = limit;
+        return true;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::writeResetInstruction(uint8_t data)
+    {
+        waitWhileBusy();
+
+        setRegister(INSTRUCTION_REGISTER);
+        LCD4PICO_TRACED(traceAccess(bus.now(), bit_mode == _8BIT ? 0 : Trace::UpperNibble, data));
+        if (bit_mode == _8BIT)
+            bus.write(data);
+        else
+            bus.writeUpperNibble(data);
+        LCD4PICO_PERF(countAccess(false, 1));
+        LCD4PICO_PERF(perf.instructions++);
+    }
+
+#ifdef LCD4PICO_TRACE
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::setTrace(Trace *trace)
+    {
+        this->trace = trace;
+        if (trace)
+            trace->bitMode = bit_mode;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport>
+    void LCD4PicoBase<bit_mode, Transport>::traceAccess(uint64_t start_us, uint8_t flags, uint8_t data)
+    {
+        if (trace)
+            trace->record(start_us, flags, data);
     }
+#endif
 }
@@ -1,13 +1,26 @@
 #pragma once
 #include "pico/stdlib.h"
 #include "../Enums.hpp"
-
-#define WRITE_ONLY UINT8_MAX
+#include "../Transport/BitBangTransport.hpp"
+#include "PerfCounters.hpp"
+#include "Trace.hpp"
 
 #ifndef INSTRUCTION_WAITING_TIME
 #define INSTRUCTION_WAITING_TIME 50
 #endif
 
+#ifndef LONG_INSTRUCTION_WAITING_TIME
+#define LONG_INSTRUCTION_WAITING_TIME 2000 // clear display and return home in write only mode
+#endif
+
+// datasheet execution times in us (fosc = 270 kHz)
+#define EXECUTION_TIME 37
+#define LONG_EXECUTION_TIME 1520
+
+// execution times for the slowest oscillator (fosc = 190 kHz), after that the busy flag doesn't need to be read
+#define SAFE_EXECUTION_TIME 53
+#define SAFE_LONG_EXECUTION_TIME 2160
+
 #define INSTRUCTION_REGISTER 0
 #define DATA_REGISTER 1
 
@@ -35,22 +48,128 @@
 #define BUSY_FLAG 0b10000000
 #define ADDRESS_COUNTER 0b01111111
 
+#define SECOND_LINE_ADDRESS 0x40
+#define DDRAM_LINE_LENGTH 40
+#define DDRAM_SIZE 80
+#define CGRAM_SIZE 64
+
+#define CALIBRATION_ROUNDS 4
+
+// datasheet initialization: time from power on to the first instruction and the waits after the first two
+// function sets of the reset sequence (upper limits when the busy flag is read)
+#define POWER_ON_TIME 40000
+#define RESET_WAITING_TIME 4100
+#define SHORT_RESET_WAITING_TIME 100
+
+#include "TimingProfile.hpp" // uses the waiting time macros above
+
 namespace lcd4pico
 {
-    template <const Bit_Mode bit_mode>
+    /**
+     * @brief A copy of the display memory: the DDRAM in the order the address counter steps through it from 0x00
+     *        (in 2 line mode cells 0-39 are 0x00-0x27 and cells 40-79 are 0x40-0x67) and the 8 custom characters.
+     *
+     */
+    struct ScreenSnapshot
+    {
+        uint8_t ddram[DDRAM_SIZE];
+        uint8_t cgram[CGRAM_SIZE];
+    };
+
+    /**
+     * @brief Whether `Transport` works in `bit_mode`: a transport that is wired for one mode only declares it as `BIT_MODE`.
+     *
+     */
+    template <class Transport>
+    constexpr auto supportsBitMode(Bit_Mode bit_mode, int) -> decltype(Transport::BIT_MODE, bool())
+    {
+        return Transport::BIT_MODE == bit_mode;
+    }
+
+    template <class Transport>
+    constexpr bool supportsBitMode(Bit_Mode, long)
+    {
+        return true;
+    }
+
+    /**
+     * @brief Whether the transport can probe the display for a warm start: a transport that can't tell the displays apart
+     *        at the moment (e.g. a broadcast on a shared bus) declares `canProbe()`.
+     *
+     */
+    template <class Transport>
+    auto canProbe(const Transport &transport, int) -> decltype(transport.canProbe())
+    {
+        return transport.canProbe();
+    }
+
+    template <class Transport>
+    bool canProbe(const Transport &, long)
+    {
+        return true;
+    }
+
+    template <const Bit_Mode bit_mode, class Transport = BitBangTransport<bit_mode>>
     class LCD4PicoBase
     {
+        static_assert(supportsBitMode<Transport>(bit_mode, 0), "the transport doesn't support this bit mode");
+
     protected:
+        Transport bus;
+
         bool isFunctionSet = false;
-        bool isInWriteMode = false;
         bool writeOnlyMode = true;
+        bool incrementsCursor = true;
+        bool registerSelect = INSTRUCTION_REGISTER;
+        bool registerKnown = false; // false until the RS pin was set once
+
+        // model of the display's address counter, updated with every instruction and data transfer
+        bool addressKnown = false;   // false until the address was set by clear, home or set CGRAM/DDRAM
+        bool addressInCGRAM = false;
+        uint8_t addressCounter = 0;
+        bool twoLineMode = false;    // the DDRAM address wraps after each line in 2 line mode
+        bool shiftsOnEntry = false;
+        bool shiftKnown = false;     // false until the display shift was reset by clear or home
+        uint8_t displayShift = 0;    // number of positions the display is shifted to the left (0 - lineLength() - 1)
+
+        uint64_t nominalDeadline = 0; // the last instruction finishes around here (bus time in us)
+        uint64_t safeDeadline = 0;    // the last instruction has surely finished here
+        TimingProfile timing;         // waiting times without the busy flag
+
+        uint8_t batchDepth = 0;
+
+        static constexpr uint8_t WARM_START_PROBES[] = {0x45, 0x1A}; // DDRAM addresses, valid in 1 and 2 line mode
+
+#ifdef LCD4PICO_PERF_COUNTERS
+        PerfCounters perf;
+        bool lastAccessWasRead = false;
+        LatencyHistogram PerfCounters::*pendingLongInstruction = nullptr; // the clear or home the display is executing
+#endif
 
-    public:
-        const uint8_t ENABLEPIN;
-        const uint8_t RSPIN;
-        const uint8_t RWPIN;
-        const uint8_t (&DATAPINS)[bit_mode];
+#ifdef LCD4PICO_TRACE
+        Trace *trace = nullptr;
+#endif
 
+        /**
+         * @brief Groups the transfers of one call: when the outermost batch ends, the transport is told to send
+         *        what it collected (`commit`), e.g. the I2C transport sends a whole string in one transaction.
+         *
+         */
+        class Batch
+        {
+        public:
+            Batch(LCD4PicoBase &lcd) : lcd(lcd) { lcd.batchDepth++; }
+            ~Batch()
+            {
+                if (!--lcd.batchDepth)
+                    lcd.bus.commit();
+            }
+
+        private:
+            LCD4PicoBase &lcd;
+        };
+
+    public:
         /**
          * @brief Construct a new object.
          * 
@@ -71,7 +190,15 @@ namespace lcd4pico
                      const uint8_t (&Data_Pins)[bit_mode]);
 
         /**
-         * @brief 
+         * @brief Construct a new object that talks to the display through `transport`, e.g. a `PioTransport`.
+         *
+         */
+        LCD4PicoBase(const Transport &transport);
+
+        /**
+         * @brief Sets the display up. If the RW pin is connected and the display is already set up (e.g. after a watchdog
+         *        reset of the Pico), only the settings are written again, otherwise the datasheet reset sequence is sent first,
+         *        which brings a 4bit interface back in step. The display content is kept in both cases.
          * 
          * @param numOfdisplayLines Number of display lines, 1 or 2, default is 2.
          * @param largeFont Large font (5x10; 1 Line mode only) or small font (5x8; default).
@@ -81,8 +208,9 @@ namespace lcd4pico
          * @param accompanyDisplayShift If true, text on the display shifts left or right (depends on `incerementCursor` setting) 
          *                              while the cursor stands still (default is false).
          * @param incrementCursor Increment (cursor moves right) or decrement (cursor moves left) the cursor (default is true).
+         * @return true if the display was already set up (warm start), e.g. to skip clearing and redrawing it.
          */
-        void setup(uint8_t numOfdisplayLines = 2,
+        bool setup(uint8_t numOfdisplayLines = 2,
                    bool largeFont = false,
                    bool blinkingCursor = false,
                    bool cursorOn = true,
@@ -99,30 +227,21 @@ namespace lcd4pico
         void displayControl(bool blinkingCursor, bool cursorOn, bool displayOn);
 
         /**
-         * @brief Sets the CGRAM address.
+         * @brief Sets the CGRAM address. Nothing is sent if the address counter already points there.
          * 
          */
         void setCGRAM(uint8_t addr);
 
         /**
-         * @brief Sets the DDRAM address.
+         * @brief Sets the DDRAM address. Nothing is sent if the address counter already points there.
          * 
          * @param addr 
          */
         void setDDRAM(uint8_t addr);
 
-        void readMode();
-
-        void writeMode();
-
-        void pulseEnable(uint64_t pulseWidth_us);
-
-        void pulseEnable();
-
-        void setEnable(bool value);
-
         /**
          * @brief Set the Register either to `INSTRUCTION_REGISTER` or `DATA_REGISTER`.
+         *        The RS pin is only written if it changes.
          * 
          * @param reg `INSTRUCTION_REGISTER` (0) or `DATA_REGISTER` (1).
          */
@@ -149,11 +268,166 @@ namespace lcd4pico
 
         void writeData(uint8_t data);
 
+        /**
+         * @brief Number of characters in a DDRAM line, after which the display shift wraps around:
+         *        40 in 2 line mode, 80 in 1 line mode.
+         *
+         */
+        uint8_t lineLength() const;
+
+        /**
+         * @brief The time (in us, `bus.now()`) from which on the display should accept the next transfer.
+         *        In busy flag mode the busy flag may still be read once before the transfer.
+         *
+         */
+        uint64_t readyAt() const;
+
+        /**
+         * @brief Blocks until the display can accept the next transfer.
+         *
+         */
+        void waitUntilReady();
+
+        /**
+         * @brief Measures the execution times of an instruction, a data write and return home with the busy flag
+         *        and adds a safety margin. Call it after `setup` on a board with the RW pin connected.
+         *        The cursor is moved home and the display shift is reset, the display content is kept.
+         *
+         * @param profile The measured profile, e.g. to be printed and stored for write only boards.
+         * @param margin_percent Added to the slowest of `CALIBRATION_ROUNDS` measurements.
+         * @return false if the busy flag can't be read.
+         */
+        bool calibrate(TimingProfile &profile, uint8_t margin_percent = 20);
+
+        /**
+         * @brief Sets the waiting times that are used instead of the busy flag (write only mode).
+         *
+         */
+        void setTimingProfile(const TimingProfile &profile);
+
+        const TimingProfile &timingProfile() const;
+
+        /**
+         * @brief Reads the whole DDRAM in one pass of the address counter. The cursor is put back.
+         *
+         * @return false if the display can't be read (write only mode).
+         */
+        bool readDDRAM(uint8_t (&cells)[DDRAM_SIZE]);
+
+        /**
+         * @brief Reads the 8 custom characters in one pass, only the lower 5 bits of each row are the pattern.
+         *
+         * @return false if the display can't be read (write only mode).
+         */
+        bool readCGRAM(uint8_t (&patterns)[CGRAM_SIZE]);
+
+        /**
+         * @brief Writes the whole DDRAM in one pass, e.g. from `readDDRAM`. The cursor is put back.
+         *
+         */
+        void writeDDRAM(const uint8_t (&cells)[DDRAM_SIZE]);
+
+        void writeCGRAM(const uint8_t (&patterns)[CGRAM_SIZE]);
+
+        /**
+         * @brief The transport the display is connected through, e.g. to switch the backlight of a `PCF8574Transport`.
+         *
+         */
+        Transport &transport();
+
+#ifdef LCD4PICO_PERF_COUNTERS
+        /**
+         * @brief A copy of the performance counters (only with `LCD4PICO_PERF_COUNTERS` defined).
+         *
+         */
+        PerfCounters perfCounters() const;
+
+        void resetPerfCounters();
+#endif
+
+#ifdef LCD4PICO_TRACE
+        /**
+         * @brief Records every transfer into `trace` (only with `LCD4PICO_TRACE` defined), nullptr stops recording.
+         *
+         */
+        void setTrace(Trace *trace);
+#endif
+
     private:
+        /**
+         * @brief Waits until the display can accept the next instruction or data.
+         *        The busy flag is only read if the last instruction may still be running, and not before
+         *        its nominal execution time has passed.
+         *
+         */
         void waitWhileBusy();
 
-        // For 4bit mode only
-        void writeUpperNibble(uint8_t data);
+        /**
+         * @brief Records when the instruction or data that was just sent will be finished.
+         *
+         */
+        void scheduleDeadline(bool reg, uint8_t data);
+
+        /**
+         * @brief Applies an instruction or data transfer to the address counter model.
+         *
+         */
+        void trackTransfer(bool reg, uint8_t data);
+
+        /**
+         * @brief Moves the modelled address counter by one, with the same wrap-around as the display.
+         *
+         */
+        void stepAddressCounter(bool increment);
+
+        /**
+         * @brief Reads or writes `length` bytes of the DDRAM or CGRAM from address 0 on. The entry mode is set to
+         *        increment without display shift for the pass if needed, then the entry mode and the cursor are restored.
+         *
+         * @param readInto Where the bytes are read to, nullptr to write the bytes from `writeFrom`.
+         */
+        bool transferRAM(bool cgram, uint8_t *readInto, const uint8_t *writeFrom, uint8_t length);
+
+        /**
+         * @brief Sends one transfer and polls the busy flag until it's finished.
+         *
+         * @return The time from the transfer to the start of the first read that wasn't busy, in us.
+         */
+        uint32_t measureExecutionTime(bool reg, uint8_t data);
+
+        /**
+         * @brief Checks whether the display is already set up and its interface is in step, e.g. after a reset of
+         *        the Pico only, by setting two DDRAM addresses and reading them back. The cursor is put back.
+         *
+         */
+        bool isConfigured();
+
+        /**
+         * @brief The datasheet reset sequence (function set three times, then 4bit mode), the display content is kept.
+         *
+         */
+        void resetInterface();
+
+        /**
+         * @brief Polls the busy flag for at most `limit_us`, in write only mode the next transfer waits for `limit_us`.
+         *
+         * @return false if the display was still busy after `limit_us`.
+         */
+        bool waitForBusyFlag(uint32_t limit_us, uint8_t &addrCounter);
+
+        // Sends the whole byte in 8bit mode, only the upper nibble in 4bit mode, e.g. while the interface mode isn't known
+        void writeResetInstruction(uint8_t data);
+
+#ifdef LCD4PICO_PERF_COUNTERS
+        void countAccess(bool read, uint8_t strobes);
+
+        // remembers a clear or home, the next wait for the display is charged to its histogram
+        void countLongInstruction(bool reg, uint8_t data);
+#endif
+
+#ifdef LCD4PICO_TRACE
+        void traceAccess(uint64_t start_us, uint8_t flags, uint8_t data);
+#endif
     };
 }
 
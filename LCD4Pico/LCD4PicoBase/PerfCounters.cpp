@@ -0,0 +1,61 @@
+#include "pico/stdlib.h"
+#include <cstdio>
+#include "PerfCounters.hpp"
+
+namespace lcd4pico
+{
+    inline void LatencyHistogram::record(uint32_t us)
+    {
+        uint8_t bucket = 0;
+        while (us >= bucketLimit(bucket))
+            bucket++;
+
+        buckets[bucket]++;
+        calls++;
+        total_us += us;
+        last_us = us;
+        if (us > max_us)
+            max_us = us;
+    }
+
+    inline void LatencyHistogram::extendLast(uint32_t us)
+    {
+        if (!calls)
+            return;
+
+        // move the call to the bucket of its new duration
+        uint8_t bucket = 0;
+        while (last_us >= bucketLimit(bucket))
+            bucket++;
+        buckets[bucket]--;
+        calls--;
+        total_us -= last_us;
+        record(last_us + us);
+    }
+
+    inline void PerfCounters::print() const
+    {
+        printf("instructions %lu, data bytes %lu, strobes %lu, busy flag reads %lu, turnarounds %lu\n",
+               (unsigned long)instructions, (unsigned long)dataBytes, (unsigned long)strobes,
+               (unsigned long)busyFlagReads, (unsigned long)turnarounds);
+        printf("waitWhileBusy %llu us, delay %llu us, deferred %llu us\n", (unsigned long long)waitWhileBusy_us,
+               (unsigned long long)delay_us, (unsigned long long)deferredWait_us);
+
+        const char *names[] = {"write", "clearDisplay", "returnHome", "createCustomCharacter"};
+        const LatencyHistogram *histograms[] = {&write, &clearDisplay, &returnHome, &createCustomCharacter};
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            const LatencyHistogram &histogram = *histograms[i];
+            printf("%s: %lu calls, max %lu us, total %llu us |", names[i], (unsigned long)histogram.calls,
+                   (unsigned long)histogram.max_us, (unsigned long long)histogram.total_us);
+            for (uint8_t bucket = 0; bucket < LatencyHistogram::BUCKETS; bucket++)
+            {
+                if (bucket < LatencyHistogram::BUCKETS - 1)
+                    printf(" <%lu: %lu", (unsigned long)LatencyHistogram::bucketLimit(bucket), (unsigned long)histogram.buckets[bucket]);
+                else
+                    printf(" more: %lu", (unsigned long)histogram.buckets[bucket]);
+            }
+            printf("\n");
+        }
+    }
+}
@@ -0,0 +1,137 @@
+#pragma once
+#include "pico/stdlib.h"
+
+// Define LCD4PICO_PERF_COUNTERS before including the library to compile the counters in; without it they cost nothing.
+#ifdef LCD4PICO_PERF_COUNTERS
+#define LCD4PICO_PERF(statement) statement
+#else
+#define LCD4PICO_PERF(statement)
+#endif
+
+namespace lcd4pico
+{
+    /**
+     * @brief Counts calls by their duration in buckets that grow by a factor of 4:
+     *        < 16 us, < 64 us, < 256 us, < 1 ms, < 4 ms, < 16 ms, < 65 ms and longer.
+     *
+     */
+    struct LatencyHistogram
+    {
+        static constexpr uint8_t BUCKETS = 8;
+
+        uint32_t buckets[BUCKETS] = {};
+        uint32_t calls = 0;
+        uint32_t max_us = 0;
+        uint64_t total_us = 0;
+        uint32_t last_us = 0;
+
+        /**
+         * @brief Upper limit (exclusive) of a bucket in us, the last bucket has no limit.
+         *
+         */
+        static constexpr uint32_t bucketLimit(uint8_t bucket)
+        {
+            return bucket < BUCKETS - 1 ? 16u << (2 * bucket) : UINT32_MAX;
+        }
+
+        void record(uint32_t us);
+
+        /**
+         * @brief Adds `us` to the last recorded call, e.g. the time the next transfer waited for it.
+         *
+         */
+        void extendLast(uint32_t us);
+    };
+
+    /**
+     * @brief What the bus layer did since the last reset (see `LCD4PicoBase::perfCounters`).
+     *
+     */
+    struct PerfCounters
+    {
+        uint32_t instructions = 0;
+        uint32_t dataBytes = 0;
+        uint32_t strobes = 0;       // E pulses, two per byte in 4bit mode
+        uint32_t busyFlagReads = 0;
+        uint32_t turnarounds = 0;   // changes of the bus direction between writing and reading
+        uint64_t waitWhileBusy_us = 0; // time spent waiting for the display
+        uint64_t delay_us = 0;         // part of it spent in the transport's delay (sleeping)
+        uint64_t deferredWait_us = 0;  // part of it spent waiting for a clear or home, charged to that call's histogram
+
+        LatencyHistogram write;
+        LatencyHistogram clearDisplay;
+        LatencyHistogram returnHome;
+        LatencyHistogram createCustomCharacter;
+
+        /**
+         * @brief Prints the counters with printf, e.g. to the UART set up by `stdio_init_all`.
+         *
+         */
+        void print() const;
+    };
+
+    /**
+     * @brief Adds the time from its construction to its destruction to `total_us`.
+     *
+     */
+    class Stopwatch
+    {
+    public:
+        Stopwatch(uint64_t &total_us) : total_us(total_us), start(time_us_64()) {}
+        ~Stopwatch() { total_us += time_us_64() - start; }
+
+    private:
+        uint64_t &total_us;
+        const uint64_t start;
+    };
+
+    /**
+     * @brief Records the time from its construction to its destruction in `histogram`,
+     *        without waits for an earlier clear or home (those are charged to that call).
+     *
+     */
+    class LatencyTimer
+    {
+    public:
+        LatencyTimer(const PerfCounters &counters, LatencyHistogram &histogram) : counters(counters),
+                                                                                  histogram(histogram),
+                                                                                  start(time_us_64()),
+                                                                                  deferredWaitBefore(counters.deferredWait_us) {}
+        ~LatencyTimer() { histogram.record(time_us_64() - start - (counters.deferredWait_us - deferredWaitBefore)); }
+
+    private:
+        const PerfCounters &counters;
+        LatencyHistogram &histogram;
+        const uint64_t start;
+        const uint64_t deferredWaitBefore;
+    };
+
+    /**
+     * @brief Charges the time from its construction to its destruction to the last call recorded in `*pending`
+     *        (a clear or home the display is still executing), then clears `pending`.
+     *
+     */
+    class DeferredWait
+    {
+    public:
+        DeferredWait(PerfCounters &counters, LatencyHistogram PerfCounters::*&pending) : counters(counters),
+                                                                                         pending(pending),
+                                                                                         start(time_us_64()) {}
+        ~DeferredWait()
+        {
+            if (!pending)
+                return;
+            uint32_t waited = time_us_64() - start;
+            counters.deferredWait_us += waited;
+            (counters.*pending).extendLast(waited);
+            pending = nullptr;
+        }
+
+    private:
+        PerfCounters &counters;
+        LatencyHistogram PerfCounters::*&pending;
+        const uint64_t start;
+    };
+}
+
+#include "PerfCounters.cpp"
@@ -0,0 +1,12 @@
+#include "pico/stdlib.h"
+#include <cstdio>
+#include "TimingProfile.hpp"
+
+namespace lcd4pico
+{
+    inline void TimingProfile::print() const
+    {
+        printf("constexpr lcd4pico::TimingProfile profile = {%u, %u, %u};\n",
+               (unsigned)instruction_us, (unsigned)dataWrite_us, (unsigned)clearOrHome_us);
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "pico/stdlib.h"
+
+namespace lcd4pico
+{
+    /**
+     * @brief Waiting times after each class of transfer, used when the busy flag can't be read (write only mode).
+     *        The default profile uses `INSTRUCTION_WAITING_TIME` and `LONG_INSTRUCTION_WAITING_TIME`,
+     *        `LCD4PicoBase::calibrate` measures one for a display on a board with the RW pin connected.
+     *        It's a plain struct, so a measured profile can be stored as a constant (in flash):
+     *
+     *        constexpr lcd4pico::TimingProfile profile = {44, 48, 1830};
+     *
+     */
+    struct TimingProfile
+    {
+        uint16_t instruction_us = INSTRUCTION_WAITING_TIME;
+        uint16_t dataWrite_us = INSTRUCTION_WAITING_TIME;
+        uint16_t clearOrHome_us = LONG_INSTRUCTION_WAITING_TIME;
+
+        /**
+         * @brief Prints the profile as a C++ initializer with printf, ready to be pasted into the firmware of write only boards.
+         *
+         */
+        void print() const;
+    };
+}
+
+#include "TimingProfile.cpp"
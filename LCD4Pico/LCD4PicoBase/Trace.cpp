@@ -0,0 +1,59 @@
+#include "pico/stdlib.h"
+#include <cstdio>
+#include "Trace.hpp"
+
+namespace lcd4pico
+{
+    inline Trace::Trace(TraceEvent *events, uint16_t capacity) : events(events),
+                                                                 mask(capacity - 1)
+    {
+    }
+
+    inline void Trace::record(uint64_t now_us, uint8_t flags, uint8_t data)
+    {
+        uint64_t delta = count ? now_us - last_us : 0;
+        last_us = now_us;
+
+        if (delta > UINT16_MAX)
+        {
+            if (delta > 0xFFFFFF)
+                delta = 0xFFFFFF;
+            events[count++ & mask] = {(uint16_t)delta, (uint8_t)(delta >> 16), Idle};
+            delta = 0;
+        }
+        events[count++ & mask] = {(uint16_t)delta, data, flags};
+    }
+
+    inline void Trace::clear()
+    {
+        count = 0;
+    }
+
+    inline uint16_t Trace::size() const
+    {
+        return count > mask ? mask + 1 : count;
+    }
+
+    inline uint32_t Trace::recorded() const
+    {
+        return count;
+    }
+
+    inline const TraceEvent &Trace::at(uint16_t index) const
+    {
+        uint32_t first = count - size();
+        return events[(first + index) & mask];
+    }
+
+    inline void Trace::dump() const
+    {
+        printf("lcd4pico trace: bits=%u events=%u recorded=%lu\n", (unsigned)bitMode, (unsigned)size(), (unsigned long)count);
+        for (uint16_t index = 0; index < size(); index++)
+        {
+            const TraceEvent &event = at(index);
+            printf("%04x%02x%02x%c", (unsigned)event.delta_us, (unsigned)event.data, (unsigned)event.flags,
+                   index % 8 == 7 || index == size() - 1 ? '\n' : ' ');
+        }
+        printf("end\n");
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include "pico/stdlib.h"
+#include "../Enums.hpp"
+
+// Define LCD4PICO_TRACE before including the library to compile the bus trace in; without it it costs nothing.
+#ifdef LCD4PICO_TRACE
+#define LCD4PICO_TRACED(statement) statement
+#else
+#define LCD4PICO_TRACED(statement)
+#endif
+
+namespace lcd4pico
+{
+    /**
+     * @brief One bus transfer, 4 bytes.
+     *
+     */
+    struct TraceEvent
+    {
+        uint16_t delta_us; // time since the previous transfer started, longer gaps are stored in an `Idle` event before
+        uint8_t data;      // the byte written or read
+        uint8_t flags;
+    };
+
+    /**
+     * @brief Records every transfer of a display (see `LCD4PicoBase::setTrace`) in a ring buffer, the oldest events are overwritten.
+     *        A record costs a clock read and a 4 byte store. `dump` prints the events as text, `host::readTrace` parses them
+     *        and `host::replayTrace` replays them into the simulated display.
+     *
+     */
+    class Trace
+    {
+    public:
+        enum Flags : uint8_t
+        {
+            Data = 1,        // RS high, otherwise the instruction register
+            Read = 2,        // RW high
+            UpperNibble = 4, // only the upper nibble was sent (4bit reset sequence)
+            Idle = 8         // no transfer: a gap of (data << 16 | delta_us) us, up to 16.7 s
+        };
+
+        /**
+         * @param events Storage for the events, has to stay valid while the trace is used.
+         * @param capacity Number of events, a power of two.
+         */
+        Trace(TraceEvent *events, uint16_t capacity);
+
+        void record(uint64_t now_us, uint8_t flags, uint8_t data);
+
+        void clear();
+
+        /**
+         * @brief Bus width of the traced display, set when the trace is attached.
+         *
+         */
+        Bit_Mode bitMode = _8BIT;
+
+        /**
+         * @brief Number of events in the buffer.
+         *
+         */
+        uint16_t size() const;
+
+        /**
+         * @brief Number of events recorded since the last `clear`, more than `size` if the oldest were overwritten.
+         *
+         */
+        uint32_t recorded() const;
+
+        /**
+         * @brief An event of the buffer, 0 is the oldest one.
+         *
+         */
+        const TraceEvent &at(uint16_t index) const;
+
+        /**
+         * @brief Prints the buffer with printf, e.g. over UART or USB:
+         *        a header line, then the events as 8 hex digits (delta, data, flags), 8 per line, then "end".
+         *
+         */
+        void dump() const;
+
+    private:
+        TraceEvent *events;
+        uint16_t mask;
+        uint32_t count = 0;
+        uint64_t last_us = 0;
+    };
+
+    /**
+     * @brief A trace with its own storage.
+     *
+     * @tparam capacity Number of events, a power of two (4 bytes each).
+     */
+    template <const uint16_t capacity = 1024>
+    class TraceBuffer : public Trace
+    {
+        static_assert(capacity && !(capacity & (capacity - 1)), "the capacity has to be a power of two");
+
+    public:
+        TraceBuffer() : Trace(storage, capacity) {}
+
+    private:
+        TraceEvent storage[capacity];
+    };
+}
+
+#include "Trace.cpp"
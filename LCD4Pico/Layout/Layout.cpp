@@ -0,0 +1,232 @@
+#include "pico/stdlib.h"
+#include "Layout.hpp"
+
+namespace lcd4pico
+{
+    template <class LCD, const uint8_t capacity>
+    Layout<LCD, capacity>::Layout(LCD &lcd, Gauges<LCD> *gauges) : lcd(lcd),
+                                                                   gauges(gauges)
+    {
+    }
+
+    template <class LCD, const uint8_t capacity>
+    uint8_t Layout<LCD, capacity>::addLabel(uint8_t row, uint8_t column, uint8_t width, uint32_t minInterval_us, uint8_t priority)
+    {
+        return add(Label, row, column, width, minInterval_us, priority);
+    }
+
+    template <class LCD, const uint8_t capacity>
+    uint8_t Layout<LCD, capacity>::addNumber(uint8_t row, uint8_t column, uint8_t width, uint8_t decimals,
+                                             uint32_t minInterval_us, uint8_t priority)
+    {
+        uint8_t region = add(Number, row, column, width, minInterval_us, priority);
+        if (region != NO_REGION)
+            regions[region].decimals = decimals;
+        return region;
+    }
+
+    template <class LCD, const uint8_t capacity>
+    uint8_t Layout<LCD, capacity>::addIcon(uint8_t row, uint8_t column, uint32_t minInterval_us, uint8_t priority)
+    {
+        return add(Icon, row, column, 1, minInterval_us, priority);
+    }
+
+    template <class LCD, const uint8_t capacity>
+    uint8_t Layout<LCD, capacity>::addBar(uint8_t row, uint8_t column, uint8_t width, uint32_t minInterval_us, uint8_t priority)
+    {
+        return add(Bar, row, column, width, minInterval_us, priority);
+    }
+
+    template <class LCD, const uint8_t capacity>
+    void Layout<LCD, capacity>::setText(uint8_t region, std::string_view text)
+    {
+        if (region >= count || regions[region].kind != Label)
+            return;
+
+        Region &label = regions[region];
+        for (uint8_t i = 0; i < label.width; i++)
+        {
+            char character = i < text.size() ? text[i] : ' ';
+            if (label.text[i] != character)
+            {
+                label.text[i] = character;
+                label.dirty = true;
+            }
+        }
+    }
+
+    template <class LCD, const uint8_t capacity>
+    void Layout<LCD, capacity>::setNumber(uint8_t region, int32_t value)
+    {
+        setValue(region, Number, value);
+    }
+
+    template <class LCD, const uint8_t capacity>
+    void Layout<LCD, capacity>::setIcon(uint8_t region, const uint8_t (&glyph)[8])
+    {
+        if (region >= count || regions[region].kind != Icon || regions[region].glyph == &glyph)
+            return;
+
+        regions[region].glyph = &glyph;
+        regions[region].dirty = true;
+    }
+
+    template <class LCD, const uint8_t capacity>
+    void Layout<LCD, capacity>::setBar(uint8_t region, uint32_t value, uint32_t max)
+    {
+        if (region >= count)
+            return;
+
+        // only a change of the filled pixel columns makes the bar dirty
+        uint32_t pixels = regions[region].width * 5;
+        uint32_t filled = max == 0 || value >= max ? pixels : (uint64_t)value * pixels / max;
+        setValue(region, Bar, filled);
+    }
+
+    template <class LCD, const uint8_t capacity>
+    void Layout<LCD, capacity>::invalidate()
+    {
+        for (uint8_t region = 0; region < count; region++)
+        {
+            regions[region].dirty = true;
+            regions[region].nextWrite = 0;
+        }
+    }
+
+    template <class LCD, const uint8_t capacity>
+    bool Layout<LCD, capacity>::isDirty(uint8_t region) const
+    {
+        return region < count && regions[region].dirty;
+    }
+
+    template <class LCD, const uint8_t capacity>
+    uint8_t Layout<LCD, capacity>::update(uint8_t maxRegions)
+    {
+        uint64_t now = time_us_64();
+
+        bool selected[capacity] = {};
+        uint8_t due = 0;
+        for (uint8_t region = 0; region < count; region++)
+        {
+            selected[region] = regions[region].dirty && now >= regions[region].nextWrite;
+            due += selected[region];
+        }
+
+        // leave out the lowest priority, of those the one that became due last
+        for (; due > maxRegions; due--)
+        {
+            uint8_t dropped = NO_REGION;
+            for (uint8_t region = 0; region < count; region++)
+            {
+                if (!selected[region])
+                    continue;
+                if (dropped == NO_REGION || regions[region].priority < regions[dropped].priority ||
+                    (regions[region].priority == regions[dropped].priority && regions[region].nextWrite > regions[dropped].nextWrite))
+                    dropped = region;
+            }
+            selected[dropped] = false;
+        }
+
+        for (uint8_t i = 0; i < count; i++)
+        {
+            uint8_t region = order[i];
+            if (!selected[region])
+                continue;
+
+            write(regions[region]);
+            regions[region].dirty = false;
+            regions[region].nextWrite = now + regions[region].minInterval_us;
+        }
+        return due;
+    }
+
+    template <class LCD, const uint8_t capacity>
+    uint8_t Layout<LCD, capacity>::add(Kind kind, uint8_t row, uint8_t column, uint8_t width, uint32_t minInterval_us, uint8_t priority)
+    {
+        if (count == capacity || row >= Geometry::ROWS || width == 0 || column + width > Geometry::COLUMNS)
+            return NO_REGION;
+
+        uint8_t region = count++;
+        Region &added = regions[region];
+        added.kind = kind;
+        added.row = row;
+        added.column = column;
+        added.width = width;
+        added.priority = priority;
+        added.decimals = 0;
+        added.dirty = true; // the region is drawn blank (or 0) until it's set
+        added.minInterval_us = minInterval_us;
+        added.nextWrite = 0;
+        added.value = 0;
+        added.glyph = nullptr;
+        for (auto &character : added.text)
+            character = ' ';
+
+        // insert into the DDRAM order
+        uint8_t address = Geometry::address(row, column);
+        uint8_t position = region;
+        for (; position > 0; position--)
+        {
+            const Region &before = regions[order[position - 1]];
+            if (Geometry::address(before.row, before.column) <= address)
+                break;
+            order[position] = order[position - 1];
+        }
+        order[position] = region;
+        return region;
+    }
+
+    template <class LCD, const uint8_t capacity>
+    void Layout<LCD, capacity>::setValue(uint8_t region, Kind kind, int32_t value)
+    {
+        if (region >= count || regions[region].kind != kind || regions[region].value == value)
+            return;
+
+        regions[region].value = value;
+        regions[region].dirty = true;
+    }
+
+    template <class LCD, const uint8_t capacity>
+    void Layout<LCD, capacity>::write(Region &region)
+    {
+        lcd.setCursor(region.row, region.column); // nothing is sent if the cursor is already there, e.g. for neighbouring regions
+
+        switch (region.kind)
+        {
+        case Label:
+            lcd.write(std::string_view(region.text, region.width));
+            break;
+        case Number:
+            lcd.writeFixed(region.value, region.decimals, region.width);
+            break;
+        case Icon:
+            if (region.glyph)
+                lcd.writeGlyph(*region.glyph);
+            else
+                lcd.write(" ");
+            break;
+        case Bar:
+            writeBar(region);
+            break;
+        }
+    }
+
+    template <class LCD, const uint8_t capacity>
+    void Layout<LCD, capacity>::writeBar(const Region &region)
+    {
+        bool fine = gauges && (gauges->isLoaded() || gauges->load());
+        uint8_t full = '#';
+        if (!fine)
+            Gauges<LCD>::fullCell(lcd, full); // '#' if the ROM has no full block and the CGRAM is full
+
+        for (uint8_t cell = 0; cell < region.width; cell++)
+        {
+            int32_t columns = region.value - cell * 5;
+            columns = columns < 0 ? 0 : columns > 5 ? 5 : columns;
+
+            // without the glyph set a cell is shown full from 3 of its 5 columns on
+            uint8_t code = fine ? gauges->horizontalCell(columns) : columns >= 3 ? full : Gauges<LCD>::SPACE;
+            lcd.writeCustomCharacter(code); // writes any character code
+        }
+    }
+}
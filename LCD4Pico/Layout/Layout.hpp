@@ -0,0 +1,132 @@
+#pragma once
+#include "pico/stdlib.h"
+#include <string_view>
+#include "../Enums.hpp"
+#include "../Gauges/Gauges.hpp"
+
+namespace lcd4pico
+{
+    /**
+     * @brief A screen made of fixed regions (labels, numbers, icons, bars) that are only written when their content changed.
+     *
+     *        The `set` methods only store the new content and mark the region dirty if it differs from what's shown.
+     *        `update` writes the dirty regions in DDRAM order, so neighbouring regions are written without cursor jumps.
+     *        A region with a minimum interval is written at most once per interval; values set in between are
+     *        collected and only the latest one is shown. All storage is in the object, nothing is allocated.
+     *
+     * @tparam LCD An `LCD4Pico` type.
+     * @tparam capacity Maximum number of regions.
+     */
+    template <class LCD, const uint8_t capacity>
+    class Layout
+    {
+    public:
+        using Geometry = typename LCD::DisplayGeometry;
+
+        static constexpr uint8_t NO_REGION = UINT8_MAX;
+
+        enum Kind : uint8_t
+        {
+            Label,
+            Number,
+            Icon,
+            Bar
+        };
+
+        /**
+         * @param gauges If set, bars have a resolution of one pixel column (the gauges' glyph set is loaded on the first update),
+         *               otherwise of one cell.
+         */
+        Layout(LCD &lcd, Gauges<LCD> *gauges = nullptr);
+
+        /**
+         * @brief Adds a text region of `width` cells at a row and column of the selected page.
+         *
+         * @param minInterval_us Minimum time between two writes of the region.
+         * @param priority If `update` may only write some of the due regions, the ones with the highest priority are written.
+         * @return The region, `NO_REGION` if the layout is full or the region doesn't fit on the display.
+         */
+        uint8_t addLabel(uint8_t row, uint8_t column, uint8_t width, uint32_t minInterval_us = 0, uint8_t priority = 0);
+
+        /**
+         * @brief Adds a right-aligned fixed-point number (see `LCD4Pico::writeFixed`), 0 until it's set.
+         *
+         */
+        uint8_t addNumber(uint8_t row, uint8_t column, uint8_t width, uint8_t decimals = 0,
+                          uint32_t minInterval_us = 0, uint8_t priority = 0);
+
+        /**
+         * @brief Adds a single cell showing a glyph (see `LCD4Pico::writeGlyph`), blank until it's set.
+         *
+         */
+        uint8_t addIcon(uint8_t row, uint8_t column, uint32_t minInterval_us = 0, uint8_t priority = 0);
+
+        /**
+         * @brief Adds a horizontal bar of `width` cells, empty until it's set.
+         *
+         */
+        uint8_t addBar(uint8_t row, uint8_t column, uint8_t width, uint32_t minInterval_us = 0, uint8_t priority = 0);
+
+        /**
+         * @brief Sets the text of a label, it's cut at the width of the region (in bytes) and filled with spaces.
+         *
+         */
+        void setText(uint8_t region, std::string_view text);
+
+        void setNumber(uint8_t region, int32_t value);
+
+        /**
+         * @param glyph Has to stay valid while the layout is used, e.g. from `lcd4pico::symbols`.
+         */
+        void setIcon(uint8_t region, const uint8_t (&glyph)[8]);
+
+        void setBar(uint8_t region, uint32_t value, uint32_t max);
+
+        /**
+         * @brief Marks all regions dirty and due, e.g. after the display was cleared.
+         *
+         */
+        void invalidate();
+
+        bool isDirty(uint8_t region) const;
+
+        /**
+         * @brief Writes the regions that are dirty and due, in the order of their DDRAM addresses.
+         *
+         * @param maxRegions Writes at most this many regions, the ones with the highest priority
+         *                   (and of equal priority, the ones that are due the longest).
+         * @return The number of regions written.
+         */
+        uint8_t update(uint8_t maxRegions = capacity);
+
+    private:
+        struct Region
+        {
+            Kind kind;
+            uint8_t row;
+            uint8_t column;
+            uint8_t width;
+            uint8_t priority;
+            uint8_t decimals;
+            bool dirty;
+            uint32_t minInterval_us;
+            uint64_t nextWrite; // time_us_64() from which on the region may be written again
+            int32_t value;      // number, or filled pixel columns of a bar
+            const uint8_t (*glyph)[8];
+            char text[Geometry::COLUMNS];
+        };
+
+        LCD &lcd;
+        Gauges<LCD> *gauges;
+        Region regions[capacity];
+        uint8_t order[capacity]; // regions sorted by DDRAM address
+        uint8_t count = 0;
+
+        uint8_t add(Kind kind, uint8_t row, uint8_t column, uint8_t width, uint32_t minInterval_us, uint8_t priority);
+        void setValue(uint8_t region, Kind kind, int32_t value);
+        void write(Region &region);
+        void writeBar(const Region &region);
+    };
+}
+
+#include "Layout.cpp"
@@ -0,0 +1,57 @@
+#include "pico/stdlib.h"
+#include <atomic>
+#include "Mailbox.hpp"
+
+namespace lcd4pico
+{
+    template <class T>
+    void Mailbox<T>::publish(const T &value)
+    {
+        // the slot of the latest value and the slot that is being read are taken, the third one is free
+        uint32_t latestSlot = latest.load() & SLOT_MASK;
+        uint32_t readingSlot = reading.load();
+        uint32_t slot = 0;
+        while (slot == latestSlot || slot == readingSlot)
+            slot++;
+
+        slots[slot] = value;
+        sequence = (sequence + 1) & (UINT32_MAX >> SLOT_BITS);
+        if (!sequence) // 0 means nothing published
+            sequence = 1;
+        latest.store(sequence << SLOT_BITS | slot);
+    }
+
+    template <class T>
+    const T *Mailbox<T>::acquire()
+    {
+        uint32_t current = latest.load();
+        if (current >> SLOT_BITS == acquired)
+            return nullptr;
+
+        // claim the slot, then make sure it's still the latest one: if a newer value was published in between,
+        // the producer may already be writing into the claimed slot
+        while (true)
+        {
+            reading.store(current & SLOT_MASK);
+            uint32_t check = latest.load();
+            if (check == current)
+                break;
+            current = check;
+        }
+
+        acquired = current >> SLOT_BITS;
+        return &slots[current & SLOT_MASK];
+    }
+
+    template <class T>
+    bool Mailbox<T>::pending() const
+    {
+        return latest.load() >> SLOT_BITS != acquired;
+    }
+
+    template <class T>
+    uint32_t Mailbox<T>::published() const
+    {
+        return latest.load() >> SLOT_BITS;
+    }
+}
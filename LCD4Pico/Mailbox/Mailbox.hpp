@@ -0,0 +1,60 @@
+#pragma once
+#include "pico/stdlib.h"
+#include <atomic>
+
+namespace lcd4pico
+{
+    /**
+     * @brief Passes values from one producer (e.g. core 0) to one consumer (e.g. core 1) without locks.
+     *        Only the latest value is kept: values published while the consumer is busy replace each other,
+     *        they are never queued.
+     *
+     *        `publish` is wait-free and doesn't allocate, `acquire` is lock-free. Three slots are used,
+     *        one for the producer, one for the consumer and one for the latest published value.
+     *        Only atomic loads and stores are used (no read-modify-write), so it also works on the Cortex-M0+.
+     *
+     * @tparam T The value type, e.g. a `TextFrame`. It is copied by `publish`.
+     */
+    template <class T>
+    class Mailbox
+    {
+    public:
+        /**
+         * @brief Copies `value` into a free slot and makes it the latest value (producer only).
+         *
+         */
+        void publish(const T &value);
+
+        /**
+         * @brief Returns the latest value if it's newer than the value returned last time, nullptr otherwise (consumer only).
+         *        The value stays valid and unchanged until the next call of `acquire`.
+         *
+         */
+        const T *acquire();
+
+        /**
+         * @brief Whether there is a value that wasn't acquired yet (consumer only).
+         *
+         */
+        bool pending() const;
+
+        /**
+         * @brief Sequence number of the latest value, counts the published values (wraps after 2^30).
+         *
+         */
+        uint32_t published() const;
+
+    private:
+        static constexpr uint32_t SLOT_BITS = 2;
+        static constexpr uint32_t SLOT_MASK = (1u << SLOT_BITS) - 1;
+        static constexpr uint32_t NO_SLOT = 3;
+
+        T slots[3] = {};
+        std::atomic<uint32_t> latest{0};       // (sequence number << SLOT_BITS) | slot, sequence 0 means nothing published
+        std::atomic<uint32_t> reading{NO_SLOT}; // slot the consumer is reading, written by the consumer only
+        uint32_t sequence = 0;                 // producer only
+        uint32_t acquired = 0;                 // sequence number acquired last, consumer only
+    };
+}
+
+#include "Mailbox.cpp"
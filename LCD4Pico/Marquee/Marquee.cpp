@@ -0,0 +1,88 @@
+#include "pico/stdlib.h"
+#include <string_view>
+#include "Marquee.hpp"
+
+namespace lcd4pico
+{
+    template <class LCD>
+    Marquee<LCD>::Marquee(LCD &lcd, uint8_t row) : lcd(lcd),
+                                                   lineAddress(row ? SECOND_LINE_ADDRESS : 0)
+    {
+        static_assert(LCD::DisplayGeometry::ROWS <= 2, "the display shift moves whole DDRAM lines");
+    }
+
+    template <class LCD>
+    void Marquee<LCD>::start(std::string_view text, uint32_t interval_us, uint8_t gap)
+    {
+        lineLength = lcd.lineLength();
+        if (lineAddress && lineLength != DDRAM_LINE_LENGTH)
+            return; // 1 line mode has no second DDRAM line
+
+        this->text = text;
+        this->interval_us = interval_us;
+        period = text.size() + gap > lineLength ? text.size() + gap : lineLength;
+
+        lcd.returnHome();
+        lcd.moveCursorTo(lineAddress);
+        for (uint8_t cell = 0; cell < lineLength; cell++)
+            lcd.writeCustomCharacter(characterAt(cell)); // writes any character code
+
+        steps = 0;
+        cellPending = false;
+        nextStep = time_us_64() + interval_us;
+        running = true;
+    }
+
+    template <class LCD>
+    void Marquee<LCD>::stop()
+    {
+        running = false;
+    }
+
+    template <class LCD>
+    bool Marquee<LCD>::isRunning() const
+    {
+        return running;
+    }
+
+    template <class LCD>
+    bool Marquee<LCD>::tick()
+    {
+        if (!running)
+            return false;
+
+        uint64_t now = time_us_64();
+        if (lcd.readyAt() > now)
+            return false;
+
+        if (cellPending)
+        {
+            // the cell that just left the window on the left shows up again on the right after the hidden part
+            uint8_t cell = (steps - 1) % lineLength;
+            lcd.moveCursorTo(lineAddress + cell); // usually no transfer, the address counter is already there
+            lcd.writeCustomCharacter(characterAt(steps - 1 + lineLength));
+            cellPending = false;
+            return true;
+        }
+
+        if (now < nextStep)
+            return false;
+
+        lcd.shiftDisplay(Direction::Left);
+        steps++;
+        nextStep += interval_us;
+        if (nextStep < now)
+            nextStep = now + interval_us; // don't catch up after a long pause
+
+        // a text that fits into the line is already there
+        cellPending = period > lineLength;
+        return true;
+    }
+
+    template <class LCD>
+    uint8_t Marquee<LCD>::characterAt(uint32_t position) const
+    {
+        position %= period;
+        return position < text.size() ? text[position] : ' ';
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include "pico/stdlib.h"
+#include <string_view>
+#include "../Enums.hpp"
+#include "../LCD4PicoBase/LCD4PicoBase.hpp"
+
+namespace lcd4pico
+{
+    /**
+     * @brief Scrolls a text through a row with the display shift instruction, so a step costs one instruction
+     *        instead of rewriting the whole row.
+     *
+     *        The text is loaded into the row's DDRAM line once (40 characters, 80 in 1 line mode). Texts longer than that are streamed:
+     *        with every step only the character that enters the hidden part of the line is written.
+     *        The display shift moves all rows, so the other row scrolls too (use it for e.g. a second marquee or leave it empty).
+     *        Only for displays with up to 2 rows and without buffered mode.
+     *
+     * @tparam LCD An `LCD4Pico` type.
+     */
+    template <class LCD>
+    class Marquee
+    {
+    private:
+        LCD &lcd;
+        const uint8_t lineAddress; // 0x00 or 0x40
+
+        std::string_view text;
+        uint8_t lineLength = DDRAM_LINE_LENGTH; // characters of the DDRAM line, the display shift wraps after them
+        uint16_t period = DDRAM_LINE_LENGTH;    // length of the text and the gap, at least one DDRAM line
+        uint32_t interval_us = 0;
+        uint64_t nextStep = 0;
+        uint32_t steps = 0;
+        bool running = false;
+        bool cellPending = false; // a character still has to be written into the hidden part
+
+    public:
+        /**
+         * @brief Construct a new object.
+         *
+         * @param row Row 0 or 1 (1 needs the 2 line mode).
+         */
+        Marquee(LCD &lcd, uint8_t row = 0);
+
+        /**
+         * @brief Loads the text and starts scrolling to the left. Returns the display shift to home (blocking).
+         *        Doesn't start on row 1 if the display is in 1 line mode.
+         *
+         * @param text Has to stay valid while the marquee is running.
+         * @param interval_us Time between two steps.
+         * @param gap Number of spaces between the end of the text and its start, if the text is longer than the display.
+         */
+        void start(std::string_view text, uint32_t interval_us, uint8_t gap = 4);
+
+        void stop();
+
+        bool isRunning() const;
+
+        /**
+         * @brief Does at most one transfer and never waits, call it as often as possible, e.g. from the main loop.
+         *
+         * @return true if something was sent.
+         */
+        bool tick();
+
+    private:
+        uint8_t characterAt(uint32_t position) const;
+    };
+}
+
+#include "Marquee.cpp"
@@ -0,0 +1,71 @@
+#include "pico/stdlib.h"
+#include "MultiDisplay.hpp"
+
+namespace lcd4pico
+{
+    template <const Bit_Mode bit_mode, const uint8_t panels, class LCD>
+    MultiDisplay<bit_mode, panels, LCD>::MultiDisplay(SharedBus<bit_mode, panels> &bus, LCD (&displays)[panels]) : bus(bus),
+                                                                                                                 displays(displays)
+    {
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels, class LCD>
+    LCD &MultiDisplay<bit_mode, panels, LCD>::operator[](uint8_t panel)
+    {
+        return displays[panel];
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels, class LCD>
+    template <class Operation>
+    void MultiDisplay<bit_mode, panels, LCD>::broadcast(Operation operation)
+    {
+        for (auto &display : displays)
+            display.waitUntilReady();
+
+        bus.beginBroadcast();
+        for (auto &display : displays)
+        {
+            operation(display);
+            bus.muteBroadcast(); // the other displays only follow the state
+        }
+        bus.endBroadcast();
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels, class LCD>
+    void MultiDisplay<bit_mode, panels, LCD>::flush()
+    {
+        bool pending[panels];
+        uint8_t remaining = panels;
+        for (auto &p : pending)
+            p = true;
+
+        while (remaining)
+        {
+            uint64_t now = time_us_64();
+            uint64_t earliest = UINT64_MAX;
+            bool sent = false;
+
+            for (uint8_t panel = 0; panel < panels; panel++)
+            {
+                if (!pending[panel])
+                    continue;
+
+                uint64_t readyAt = displays[panel].readyAt();
+                if (readyAt > now)
+                {
+                    if (readyAt < earliest)
+                        earliest = readyAt;
+                    continue;
+                }
+
+                pending[panel] = displays[panel].flushStep();
+                if (!pending[panel])
+                    remaining--;
+                sent = true;
+            }
+
+            if (!sent && remaining)
+                sleep_us(earliest - now); // every display is busy
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "pico/stdlib.h"
+#include "../Enums.hpp"
+#include "../LCD4Pico.hpp"
+#include "../Transport/SharedBusTransport.hpp"
+
+namespace lcd4pico
+{
+    /**
+     * @brief Drives several displays that share one bus (see `SharedBus`).
+     *
+     *        `broadcast` sends the same operations to all displays with one transfer each,
+     *        `flush` interleaves the buffered updates of the displays: while one display is still busy, e.g. after a clear,
+     *        the others get their data.
+     *
+     */
+    template <const Bit_Mode bit_mode, const uint8_t panels, class LCD = LCD4Pico<bit_mode, PanelTransport<bit_mode, panels>>>
+    class MultiDisplay
+    {
+    private:
+        SharedBus<bit_mode, panels> &bus;
+        LCD (&displays)[panels];
+
+    public:
+        MultiDisplay(SharedBus<bit_mode, panels> &bus, LCD (&displays)[panels]);
+
+        LCD &operator[](uint8_t panel);
+
+        /**
+         * @brief Runs `operation` for every display, but only the transfers of the first display are sent,
+         *        strobing the enable pins of all displays. Use it only for operations that do the same on every display,
+         *        e.g. `setup`, `clearDisplay`, `createCustomCharacter` or `play`.
+         *        A broadcast `setup` always sends the reset sequence, per display `setup` calls detect a warm start.
+         *
+         *        rack.broadcast([](auto &lcd) { lcd.setup(); });
+         *
+         */
+        template <class Operation>
+        void broadcast(Operation operation);
+
+        /**
+         * @brief Flushes all displays (buffered mode), always sending to a display that is ready.
+         *
+         */
+        void flush();
+    };
+}
+
+#include "MultiDisplay.cpp"
@@ -0,0 +1,50 @@
+#include "pico/stdlib.h"
+#include "Sequence.hpp"
+
+namespace lcd4pico
+{
+    template <const size_t capacity>
+    constexpr Sequence<capacity> &Sequence<capacity>::instruction(uint8_t instruction)
+    {
+        append(instruction);
+        return *this;
+    }
+
+    template <const size_t capacity>
+    constexpr Sequence<capacity> &Sequence<capacity>::clear()
+    {
+        return instruction(0x1);
+    }
+
+    template <const size_t capacity>
+    constexpr Sequence<capacity> &Sequence<capacity>::moveTo(uint8_t ddramAddress)
+    {
+        return instruction(SET_DDRAM | ddramAddress);
+    }
+
+    template <const size_t capacity>
+    constexpr Sequence<capacity> &Sequence<capacity>::text(const char *str)
+    {
+        for (; *str; str++)
+            character(*str);
+        return *this;
+    }
+
+    template <const size_t capacity>
+    constexpr Sequence<capacity> &Sequence<capacity>::character(uint8_t character)
+    {
+        append(DATA | character);
+        return *this;
+    }
+
+    template <const size_t capacity>
+    constexpr void Sequence<capacity>::append(uint16_t operation)
+    {
+        if (length >= capacity)
+        {
+            overflowed = true;
+            return;
+        }
+        operations[length++] = operation;
+    }
+}
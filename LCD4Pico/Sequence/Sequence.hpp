@@ -0,0 +1,66 @@
+#pragma once
+#include "pico/stdlib.h"
+#include <cstddef>
+#include "../LCD4PicoBase/LCD4PicoBase.hpp"
+
+namespace lcd4pico
+{
+    /**
+     * @brief A list of instructions and characters that is encoded at compile time and stored in flash,
+     *        e.g. a splash screen or the fixed labels of a screen. Play it with `LCD4Pico::play`.
+     *
+     *        constexpr auto splash = lcd4pico::Sequence<32>().clear().moveTo(0x04).text("LCD4Pico").moveTo(0x40).text("v1.0");
+     *
+     *        When played, jumps to the address the cursor is already at are left out.
+     *
+     * @tparam capacity Maximum number of operations. Operations beyond it are dropped and `overflowed` is set,
+     *                  check it with `static_assert(!splash.overflowed)` for constexpr sequences.
+     */
+    template <const size_t capacity>
+    class Sequence
+    {
+    public:
+        static constexpr uint16_t DATA = 1 << 8; // RS flag of an operation, the lower 8 bits are the byte
+
+        uint16_t operations[capacity] = {};
+        size_t length = 0;
+        bool overflowed = false; // operations were dropped because the capacity was exceeded
+
+        constexpr Sequence() = default;
+
+        /**
+         * @brief Appends any instruction, e.g. `DISPLAY_CONTROL | DISPLAY_ON`.
+         *
+         */
+        constexpr Sequence &instruction(uint8_t instruction);
+
+        /**
+         * @brief Appends clear display.
+         *
+         */
+        constexpr Sequence &clear();
+
+        /**
+         * @brief Appends a jump to a DDRAM address.
+         *
+         */
+        constexpr Sequence &moveTo(uint8_t ddramAddress);
+
+        /**
+         * @brief Appends the characters of a null terminated string.
+         *
+         */
+        constexpr Sequence &text(const char *str);
+
+        /**
+         * @brief Appends one character, e.g. the code of a custom character.
+         *
+         */
+        constexpr Sequence &character(uint8_t character);
+
+    private:
+        constexpr void append(uint16_t operation);
+    };
+}
+
+#include "Sequence.cpp"
@@ -0,0 +1,216 @@
+#include "pico/stdlib.h"
+#include "../Enums.hpp"
+#include "BitBangTransport.hpp"
+
+namespace lcd4pico
+{
+    template <const Bit_Mode bit_mode>
+    BitBangTransport<bit_mode>::BitBangTransport(uint8_t Enable_Pin,
+                                                 uint8_t RS_Pin,
+                                                 uint8_t RW_Pin,
+                                                 const uint8_t (&Data_Pins)[bit_mode]) :
+
+                                                                                         ENABLEPIN(Enable_Pin),
+                                                                                         RSPIN(RS_Pin),
+                                                                                         RWPIN(RW_Pin),
+                                                                                         DATAPINS(Data_Pins)
+    {
+        buildDataPinTable();
+    }
+
+    template <const Bit_Mode bit_mode>
+    BitBangTransport<bit_mode>::BitBangTransport(uint8_t Enable_Pin,
+                                                 uint8_t RS_Pin,
+                                                 const uint8_t (&Data_Pins)[bit_mode]) :
+
+                                                                                         ENABLEPIN(Enable_Pin),
+                                                                                         RSPIN(RS_Pin),
+                                                                                         RWPIN(WRITE_ONLY),
+                                                                                         DATAPINS(Data_Pins)
+    {
+        buildDataPinTable();
+    }
+
+    template <const Bit_Mode bit_mode>
+    void BitBangTransport<bit_mode>::buildDataPinTable()
+    {
+        enablePinMask = 1u << ENABLEPIN;
+        dataPinMask = 0;
+        for (uint8_t pin : DATAPINS)
+            dataPinMask |= 1u << pin;
+
+        for (uint16_t value = 0; value < (1 << bit_mode); value++)
+        {
+            dataPinValues[value] = 0;
+            for (uint8_t pin = 0; pin < bit_mode; pin++)
+            {
+                if (value & (1 << pin))
+                    dataPinValues[value] |= 1u << DATAPINS[pin];
+            }
+        }
+    }
+
+    template <const Bit_Mode bit_mode>
+    void BitBangTransport<bit_mode>::init()
+    {
+        gpio_init(ENABLEPIN);
+        gpio_init(RSPIN);
+        if (RWPIN != WRITE_ONLY)
+        {
+            gpio_init(RWPIN);
+            gpio_set_dir(RWPIN, GPIO_OUT);
+        }
+        gpio_set_dir(ENABLEPIN, GPIO_OUT);
+        gpio_set_dir(RSPIN, GPIO_OUT);
+        setEnable(0);
+        for (uint8_t pin : DATAPINS)
+            gpio_init(pin); // only here, switching the direction later doesn't touch the pin functions
+        writeMode(); // the data pins have to be set up before the first transfer, that may be a read
+    }
+
+    template <const Bit_Mode bit_mode>
+    bool BitBangTransport<bit_mode>::canRead() const
+    {
+        return RWPIN != WRITE_ONLY;
+    }
+
+    template <const Bit_Mode bit_mode>
+    void BitBangTransport<bit_mode>::setRegister(bool reg)
+    {
+        gpio_put(RSPIN, reg);
+    }
+
+    template <const Bit_Mode bit_mode>
+    void BitBangTransport<bit_mode>::write(uint8_t data)
+    {
+        writeMode();
+
+        if (bit_mode == _8BIT)
+            strobeData(data);
+        else
+        {
+            strobeData(data >> 4);
+            strobeData(data & 0xF);
+        }
+    }
+
+    template <const Bit_Mode bit_mode>
+    void BitBangTransport<bit_mode>::writeUpperNibble(uint8_t data)
+    {
+        writeMode();
+
+        strobeData(data >> 4);
+    }
+
+    template <const Bit_Mode bit_mode>
+    uint8_t BitBangTransport<bit_mode>::read()
+    {
+        readMode();
+
+        setEnable(1);
+        sleep_us(1);
+
+        uint8_t data = 0;
+
+        uint32_t pins = gpio_get_all();
+        for (uint8_t pin = 0; pin < bit_mode; pin++)
+        {
+            uint8_t bit = (pins >> DATAPINS[pin]) & 1;
+            data |= bit << pin;
+        }
+
+        setEnable(0);
+        if (bit_mode == _4BIT)
+        {
+            sleep_us(1);
+            setEnable(1);
+            sleep_us(1);
+
+            data <<= 4;
+            pins = gpio_get_all();
+            for (uint8_t pin = 0; pin < bit_mode; pin++)
+            {
+                uint8_t bit = (pins >> DATAPINS[pin]) & 1;
+                data |= bit << pin;
+            }
+
+            setEnable(0);
+        }
+        return data;
+    }
+
+    template <const Bit_Mode bit_mode>
+    void BitBangTransport<bit_mode>::delay(uint32_t us)
+    {
+        sleep_us(us);
+    }
+
+    template <const Bit_Mode bit_mode>
+    void BitBangTransport<bit_mode>::sync()
+    {
+    }
+
+    template <const Bit_Mode bit_mode>
+    void BitBangTransport<bit_mode>::commit()
+    {
+    }
+
+    template <const Bit_Mode bit_mode>
+    uint64_t BitBangTransport<bit_mode>::now() const
+    {
+        return time_us_64();
+    }
+
+    template <const Bit_Mode bit_mode>
+    void BitBangTransport<bit_mode>::readMode()
+    {
+        if (!isInWriteMode)
+            return;
+        gpio_set_dir_in_masked(dataPinMask); // release the data pins before the display drives them
+        gpio_put(RWPIN, 1);
+        isInWriteMode = false;
+    }
+
+    template <const Bit_Mode bit_mode>
+    void BitBangTransport<bit_mode>::writeMode()
+    {
+        if (isInWriteMode)
+            return; // don't switch to write mode if it's alreay in it
+        if (RWPIN != WRITE_ONLY)
+            gpio_put(RWPIN, 0);
+        gpio_set_dir_out_masked(dataPinMask);
+        isInWriteMode = true;
+    }
+
+    template <const Bit_Mode bit_mode>
+    void BitBangTransport<bit_mode>::pulseEnable(uint64_t pulseWidth_us)
+    {
+        setEnable(1);
+        sleep_us(pulseWidth_us);
+        setEnable(0);
+    }
+
+    template <const Bit_Mode bit_mode>
+    void BitBangTransport<bit_mode>::pulseEnable()
+    {
+        setEnable(1);
+        sleep_us(1);
+        setEnable(0);
+    }
+
+    template <const Bit_Mode bit_mode>
+    void BitBangTransport<bit_mode>::setEnable(bool value)
+    {
+        gpio_put(ENABLEPIN, value);
+    }
+
+    template <const Bit_Mode bit_mode>
+    void BitBangTransport<bit_mode>::strobeData(uint8_t value)
+    {
+        // RS is already stable here, so the data may change together with the rising edge of E,
+        // it only has to be valid before the falling edge
+        gpio_put_masked(dataPinMask | enablePinMask, dataPinValues[value] | enablePinMask);
+        busy_wait_us_32(1); // not sleep_us, writes may come from an interrupt handler (QueuedTransport)
+        setEnable(0);
+    }
+}
@@ -0,0 +1,135 @@
+#pragma once
+#include "pico/stdlib.h"
+#include "../Enums.hpp"
+
+#define WRITE_ONLY UINT8_MAX
+
+namespace lcd4pico
+{
+    /**
+     * @brief Drives the display bus directly from the CPU with GPIO writes (default transport).
+     *
+     * Every transport provides the same methods, `LCD4PicoBase` uses only those:
+     * `init`, `canRead`, `setRegister`, `write`, `writeUpperNibble`, `read`, `delay`, `sync` and `now`.
+     * Optional are `BIT_MODE` and `canProbe` (see `supportsBitMode` and `canProbe` in LCD4PicoBase.hpp).
+     */
+    template <const Bit_Mode bit_mode>
+    class BitBangTransport
+    {
+    private:
+        bool isInWriteMode = false;
+
+        uint32_t enablePinMask;
+        uint32_t dataPinMask;
+        uint32_t dataPinValues[1 << bit_mode]; // GPIO output values for every possible nibble/byte
+
+    public:
+        const uint8_t ENABLEPIN;
+        const uint8_t RSPIN;
+        const uint8_t RWPIN;
+        const uint8_t (&DATAPINS)[bit_mode];
+
+        /**
+         * @brief Construct a new object.
+         *
+         * @param Data_Pins Data pins order: (D0,D1,D2,D3,) D4,D5,D6,D7 .
+         */
+        BitBangTransport(uint8_t Enable_Pin,
+                         uint8_t RS_Pin,
+                         uint8_t RW_Pin,
+                         const uint8_t (&Data_Pins)[bit_mode]);
+
+        /**
+         * @brief Construct a new object without the RW pin (write only mode; not recommended).
+         *
+         * @param Data_Pins Data pins order: (D0,D1,D2,D3,) D4,D5,D6,D7 .
+         */
+        BitBangTransport(uint8_t Enable_Pin,
+                         uint8_t RS_Pin,
+                         const uint8_t (&Data_Pins)[bit_mode]);
+
+        /**
+         * @brief Initializes the control pins.
+         *
+         */
+        void init();
+
+        /**
+         * @brief Whether the busy flag and the display memory can be read back (RW pin is connected).
+         *
+         */
+        bool canRead() const;
+
+        /**
+         * @brief Set the Register either to `INSTRUCTION_REGISTER` or `DATA_REGISTER`.
+         *
+         * @param reg `INSTRUCTION_REGISTER` (0) or `DATA_REGISTER` (1).
+         */
+        void setRegister(bool reg);
+
+        /**
+         * @brief Writes a whole byte to the selected register (two nibbles in 4bit mode).
+         *
+         */
+        void write(uint8_t data);
+
+        /**
+         * @brief Writes only the upper nibble of `data` (4bit mode only, used during the initialization).
+         *
+         */
+        void writeUpperNibble(uint8_t data);
+
+        /**
+         * @brief Reads a whole byte from the selected register (two nibbles in 4bit mode).
+         *
+         */
+        uint8_t read();
+
+        /**
+         * @brief Keeps the bus idle for at least `us` microseconds before the next transfer.
+         *
+         */
+        void delay(uint32_t us);
+
+        /**
+         * @brief Returns once every transfer is on the bus; the bit-banging transport never queues anything.
+         *
+         */
+        void sync();
+
+        /**
+         * @brief Sends the transfers the transport collected; the bit-banging transport sends every transfer right away.
+         *
+         */
+        void commit();
+
+        /**
+         * @brief Current time in microseconds, the time the next transfer would start.
+         *
+         */
+        uint64_t now() const;
+
+        void readMode();
+
+        void writeMode();
+
+        void pulseEnable(uint64_t pulseWidth_us);
+
+        void pulseEnable();
+
+        void setEnable(bool value);
+
+    private:
+        void buildDataPinTable();
+
+        /**
+         * @brief Puts the data pins into the state for `value` and raises the enable pin with the same write,
+         *        then lowers the enable pin again.
+         *
+         * @param value Nibble (4bit mode) or byte (8bit mode).
+         */
+        void strobeData(uint8_t value);
+    };
+}
+
+#include "BitBangTransport.cpp"
@@ -0,0 +1,171 @@
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "../Enums.hpp"
+#include "PCF8574Transport.hpp"
+
+namespace lcd4pico
+{
+    template <const uint16_t buffer_size>
+    PCF8574Transport<buffer_size>::PCF8574Transport(i2c_inst_t *i2c,
+                                                    uint8_t SDA_Pin,
+                                                    uint8_t SCL_Pin,
+                                                    uint8_t address,
+                                                    uint32_t baudrate) :
+
+                                                                         SDAPIN(SDA_Pin),
+                                                                         SCLPIN(SCL_Pin),
+                                                                         ADDRESS(address),
+                                                                         BAUDRATE(baudrate),
+                                                                         i2c(i2c)
+    {
+    }
+
+    template <const uint16_t buffer_size>
+    void PCF8574Transport<buffer_size>::init()
+    {
+        uint32_t baudrate = i2c_init(i2c, BAUDRATE);
+        gpio_set_function(SDAPIN, GPIO_FUNC_I2C);
+        gpio_set_function(SCLPIN, GPIO_FUNC_I2C);
+        gpio_pull_up(SDAPIN);
+        gpio_pull_up(SCLPIN);
+
+        byteTime_ns = 9000000000ull / baudrate; // 8 data bits and the acknowledge
+
+        push(control);
+        commit();
+    }
+
+    template <const uint16_t buffer_size>
+    bool PCF8574Transport<buffer_size>::canRead() const
+    {
+        return false;
+    }
+
+    template <const uint16_t buffer_size>
+    void PCF8574Transport<buffer_size>::setRegister(bool reg)
+    {
+        control = reg ? control | RS_BIT : control & ~RS_BIT;
+    }
+
+    template <const uint16_t buffer_size>
+    void PCF8574Transport<buffer_size>::write(uint8_t data)
+    {
+        strobe(data >> 4);
+        strobe(data & 0xF);
+    }
+
+    template <const uint16_t buffer_size>
+    void PCF8574Transport<buffer_size>::writeUpperNibble(uint8_t data)
+    {
+        strobe(data >> 4);
+    }
+
+    template <const uint16_t buffer_size>
+    uint8_t PCF8574Transport<buffer_size>::read()
+    {
+        return 0;
+    }
+
+    template <const uint16_t buffer_size>
+    void PCF8574Transport<buffer_size>::delay(uint32_t us)
+    {
+        // E rises at the end of the first write of the next transfer, a new transaction also starts with the address
+        uint64_t target_ns = (now() + us) * 1000;
+        uint64_t start_ns = (count ? bufferEnd_ns : now() * 1000 + byteTime_ns) + byteTime_ns;
+        if (start_ns >= target_ns)
+            return;
+
+        uint32_t padding = (target_ns - start_ns + byteTime_ns - 1) / byteTime_ns;
+        if (count + padding <= buffer_size)
+        {
+            while (padding--)
+                push(outputs); // changes nothing, E stays low
+            return;
+        }
+
+        commit();
+        uint64_t time = now();
+        if (time * 1000 < target_ns)
+            sleep_us((target_ns + 999) / 1000 - time);
+    }
+
+    template <const uint16_t buffer_size>
+    void PCF8574Transport<buffer_size>::sync()
+    {
+        commit();
+    }
+
+    template <const uint16_t buffer_size>
+    void PCF8574Transport<buffer_size>::commit()
+    {
+        if (!count)
+            return;
+
+        connected = i2c_write_blocking(i2c, ADDRESS, buffer, count, false) == count;
+        transactionCount++;
+
+        // the deadlines were calculated from the estimate, continue the clock from its end
+        lag_us = (int64_t)time_us_64() - (int64_t)((bufferEnd_ns + 999) / 1000);
+        count = 0;
+    }
+
+    template <const uint16_t buffer_size>
+    uint64_t PCF8574Transport<buffer_size>::now() const
+    {
+        if (count)
+            return (bufferEnd_ns + 999) / 1000;
+        return time_us_64() - lag_us;
+    }
+
+    template <const uint16_t buffer_size>
+    void PCF8574Transport<buffer_size>::setBacklight(bool on)
+    {
+        control = on ? control | BACKLIGHT_BIT : control & ~BACKLIGHT_BIT;
+        push(on ? outputs | BACKLIGHT_BIT : outputs & ~BACKLIGHT_BIT);
+        commit();
+    }
+
+    template <const uint16_t buffer_size>
+    bool PCF8574Transport<buffer_size>::backlight() const
+    {
+        return control & BACKLIGHT_BIT;
+    }
+
+    template <const uint16_t buffer_size>
+    bool PCF8574Transport<buffer_size>::isConnected() const
+    {
+        return connected;
+    }
+
+    template <const uint16_t buffer_size>
+    uint32_t PCF8574Transport<buffer_size>::transactions() const
+    {
+        return transactionCount;
+    }
+
+    template <const uint16_t buffer_size>
+    void PCF8574Transport<buffer_size>::push(uint8_t pins)
+    {
+        if (count == buffer_size)
+            commit();
+        if (!count)
+            bufferEnd_ns = now() * 1000 + byteTime_ns; // address byte
+
+        buffer[count++] = pins;
+        bufferEnd_ns += byteTime_ns;
+        outputs = pins;
+    }
+
+    template <const uint16_t buffer_size>
+    void PCF8574Transport<buffer_size>::strobe(uint8_t nibble)
+    {
+        uint8_t pins = (nibble << DATA_SHIFT) | control;
+
+        // RS has to be stable before E rises, so a change gets its own write
+        if ((pins & RS_BIT) != (outputs & RS_BIT))
+            push(pins);
+
+        push(pins | ENABLE_BIT);
+        push(pins);
+    }
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "../Enums.hpp"
+
+namespace lcd4pico
+{
+    /**
+     * @brief Talks to the display through a PCF8574 I2C backpack (4bit mode only: `LCD4Pico<Bit_Mode::_4BIT, PCF8574Transport<>>`).
+     *        The expander writes of one call, e.g. a whole string, are collected in a buffer and sent in one I2C transaction.
+     *        The waiting times between the transfers are filled with repeated expander writes, so the timing is kept within
+     *        the transaction; only long waits (e.g. after a clear display) end the transaction.
+     *
+     *        Wiring of the common backpacks: P0 = RS, P1 = RW (held low), P2 = E, P3 = backlight, P4-P7 = D4-D7.
+     *        The busy flag can't be read through this transport.
+     *
+     * @tparam buffer_size Maximum number of expander writes per I2C transaction.
+     */
+    template <const uint16_t buffer_size = 128>
+    class PCF8574Transport
+    {
+        // catches `PCF8574Transport<_4BIT>` and `PCF8574Transport<_8BIT>`, which would be taken as the buffer size
+        static_assert(buffer_size > _8BIT, "the template parameter is the buffer size, the transport is always in 4bit mode");
+
+    public:
+        static constexpr Bit_Mode BIT_MODE = _4BIT; // the backpack only wires D4-D7
+        static constexpr uint8_t RS_BIT = 1 << 0;
+        static constexpr uint8_t RW_BIT = 1 << 1;
+        static constexpr uint8_t ENABLE_BIT = 1 << 2;
+        static constexpr uint8_t BACKLIGHT_BIT = 1 << 3;
+        static constexpr uint8_t DATA_SHIFT = 4; // D4 on P4
+
+        const uint8_t SDAPIN;
+        const uint8_t SCLPIN;
+        const uint8_t ADDRESS;
+        const uint32_t BAUDRATE;
+
+        /**
+         * @brief Construct a new object.
+         *
+         * @param address 7 bit I2C address, 0x27 for most backpacks (0x3F with a PCF8574A).
+         */
+        PCF8574Transport(i2c_inst_t *i2c,
+                         uint8_t SDA_Pin,
+                         uint8_t SCL_Pin,
+                         uint8_t address = 0x27,
+                         uint32_t baudrate = 400000);
+
+        /**
+         * @brief Initializes the I2C peripheral and drives all outputs low except the backlight bit (backlight on).
+         *
+         */
+        void init();
+
+        bool canRead() const;
+
+        /**
+         * @brief The RS state is sent with the next expander write.
+         *
+         */
+        void setRegister(bool reg);
+
+        /**
+         * @brief Adds the expander writes for a whole byte (two nibbles) to the buffer.
+         *
+         */
+        void write(uint8_t data);
+
+        /**
+         * @brief Adds the expander writes for the upper nibble of `data` to the buffer (used during the initialization).
+         *
+         */
+        void writeUpperNibble(uint8_t data);
+
+        /**
+         * @brief Reading is not supported, always returns 0.
+         *
+         */
+        uint8_t read();
+
+        /**
+         * @brief The next transfer starts at least `us` microseconds later, the time is filled with repeated expander writes
+         *        if they fit into the buffer.
+         *
+         */
+        void delay(uint32_t us);
+
+        /**
+         * @brief Sends the buffer and returns once it's on the bus.
+         *
+         */
+        void sync();
+
+        /**
+         * @brief Sends the collected expander writes in one I2C transaction.
+         *
+         */
+        void commit();
+
+        /**
+         * @brief The time (in us) at which the next transfer would start. While writes are collected it's the end of the buffer
+         *        on the bus; the clock is kept in step with the transactions, so it may lag behind `time_us_64()`.
+         *
+         */
+        uint64_t now() const;
+
+        /**
+         * @brief Switches the backlight and sends it right away, the state is kept for all following writes.
+         *
+         */
+        void setBacklight(bool on);
+
+        bool backlight() const;
+
+        /**
+         * @brief Whether the backpack acknowledged the last transaction.
+         *
+         */
+        bool isConnected() const;
+
+        /**
+         * @brief Number of I2C transactions sent so far.
+         *
+         */
+        uint32_t transactions() const;
+
+    private:
+        i2c_inst_t *i2c;
+
+        uint8_t buffer[buffer_size];
+        uint16_t count = 0;
+        uint8_t control = BACKLIGHT_BIT; // RS and backlight bits of the next expander write
+        uint8_t outputs = 0;             // expander outputs after the last write in the buffer
+        uint32_t byteTime_ns = 0;        // lower bound for one byte on the bus
+        uint64_t bufferEnd_ns = 0;       // when the buffered writes will be on the bus
+        int64_t lag_us = 0;              // time_us_64() - now(), the time the transactions took longer than estimated
+        bool connected = false;
+        uint32_t transactionCount = 0;
+
+        void push(uint8_t pins);
+        void strobe(uint8_t nibble);
+    };
+}
+
+#include "PCF8574Transport.cpp"
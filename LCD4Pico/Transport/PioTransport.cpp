@@ -0,0 +1,255 @@
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "../Enums.hpp"
+#include "PioTransport.hpp"
+
+namespace lcd4pico
+{
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    PioTransport<bit_mode, ring_size_bits> *PioTransport<bit_mode, ring_size_bits>::instances[NUM_DMA_CHANNELS] = {};
+
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    PioTransport<bit_mode, ring_size_bits>::PioTransport(PIO pio,
+                                                         uint8_t Enable_Pin,
+                                                         uint8_t RS_Pin,
+                                                         uint8_t RW_Pin,
+                                                         uint8_t First_Data_Pin) :
+
+                                                                                   ENABLEPIN(Enable_Pin),
+                                                                                   RSPIN(RS_Pin),
+                                                                                   RWPIN(RW_Pin),
+                                                                                   FIRSTDATAPIN(First_Data_Pin),
+                                                                                   pio(pio)
+    {
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    PioTransport<bit_mode, ring_size_bits>::PioTransport(PIO pio,
+                                                         uint8_t Enable_Pin,
+                                                         uint8_t RS_Pin,
+                                                         uint8_t First_Data_Pin) :
+
+                                                                                   ENABLEPIN(Enable_Pin),
+                                                                                   RSPIN(RS_Pin),
+                                                                                   RWPIN(WRITE_ONLY),
+                                                                                   FIRSTDATAPIN(First_Data_Pin),
+                                                                                   pio(pio)
+    {
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    PioTransport<bit_mode, ring_size_bits>::PioTransport(const PioTransport &other) :
+
+                                                                                   ENABLEPIN(other.ENABLEPIN),
+                                                                                   RSPIN(other.RSPIN),
+                                                                                   RWPIN(other.RWPIN),
+                                                                                   FIRSTDATAPIN(other.FIRSTDATAPIN),
+                                                                                   pio(other.pio)
+    {
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    PioTransport<bit_mode, ring_size_bits>::~PioTransport()
+    {
+        if (dmaChannel >= 0 && instances[dmaChannel] == this)
+        {
+            dma_channel_set_irq0_enabled(dmaChannel, false);
+            instances[dmaChannel] = nullptr;
+        }
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    void PioTransport<bit_mode, ring_size_bits>::init()
+    {
+        if (RWPIN != WRITE_ONLY)
+        {
+            gpio_init(RWPIN);
+            gpio_set_dir(RWPIN, GPIO_OUT);
+            gpio_put(RWPIN, 0);
+        }
+
+        static const pio_program_t program = {PROGRAM_INSTRUCTIONS, count_of(PROGRAM_INSTRUCTIONS), -1};
+        uint offset = pio_add_program(pio, &program);
+        sm = pio_claim_unused_sm(pio, true);
+
+        for (uint8_t pin = FIRSTDATAPIN; pin < FIRSTDATAPIN + bit_mode; pin++)
+            pio_gpio_init(pio, pin);
+        pio_gpio_init(pio, RSPIN);
+        pio_gpio_init(pio, ENABLEPIN);
+        pio_sm_set_pins_with_mask(pio, sm, 0, 1u << ENABLEPIN);
+        pio_sm_set_consecutive_pindirs(pio, sm, FIRSTDATAPIN, bit_mode, true);
+        pio_sm_set_consecutive_pindirs(pio, sm, RSPIN, 1, true);
+        pio_sm_set_consecutive_pindirs(pio, sm, ENABLEPIN, 1, true);
+
+        pio_sm_config config = pio_get_default_sm_config();
+        sm_config_set_wrap(&config, offset, offset + count_of(PROGRAM_INSTRUCTIONS) - 1);
+        sm_config_set_sideset(&config, 1, false, false);
+        sm_config_set_sideset_pins(&config, ENABLEPIN);
+        sm_config_set_set_pins(&config, RSPIN, 1);
+        sm_config_set_out_pins(&config, FIRSTDATAPIN, bit_mode);
+        sm_config_set_out_shift(&config, true, false, 32);
+        sm_config_set_fifo_join(&config, PIO_FIFO_JOIN_TX);
+        sm_config_set_clkdiv(&config, (float)clock_get_hz(clk_sys) / PIO_TRANSPORT_CLOCK_HZ);
+        pio_sm_init(pio, sm, offset, &config);
+        pio_sm_set_enabled(pio, sm, true);
+
+        dmaChannel = dma_claim_unused_channel(true);
+        dma_channel_config dmaConfig = dma_channel_get_default_config(dmaChannel);
+        channel_config_set_transfer_data_size(&dmaConfig, DMA_SIZE_32);
+        channel_config_set_read_increment(&dmaConfig, true);
+        channel_config_set_write_increment(&dmaConfig, false);
+        channel_config_set_ring(&dmaConfig, false, ring_size_bits + 2); // wrap the read address around the ring
+        channel_config_set_dreq(&dmaConfig, pio_get_dreq(pio, sm, true));
+        dma_channel_configure(dmaChannel, &dmaConfig, &pio->txf[sm], ring, 0, false);
+
+        static bool irqHandlerAdded = false;
+        if (!irqHandlerAdded)
+        {
+            irq_add_shared_handler(DMA_IRQ_0, dmaIrqHandler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+            irq_set_enabled(DMA_IRQ_0, true);
+            irqHandlerAdded = true;
+        }
+        instances[dmaChannel] = this;
+        dma_channel_set_irq0_enabled(dmaChannel, true);
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    bool PioTransport<bit_mode, ring_size_bits>::canRead() const
+    {
+        return false;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    void PioTransport<bit_mode, ring_size_bits>::setRegister(bool reg)
+    {
+        registerSelect = reg;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    void PioTransport<bit_mode, ring_size_bits>::write(uint8_t data)
+    {
+        advanceQueueTime(bit_mode == _8BIT ? 1 : 2);
+        if (bit_mode == _8BIT)
+            push(encode(registerSelect, data, pendingDelay));
+        else
+        {
+            push(encode(registerSelect, data >> 4, pendingDelay));
+            push(encode(registerSelect, data & 0xF, 0));
+        }
+        pendingDelay = 0;
+        kick();
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    void PioTransport<bit_mode, ring_size_bits>::writeUpperNibble(uint8_t data)
+    {
+        advanceQueueTime(1);
+        push(encode(registerSelect, data >> 4, pendingDelay));
+        pendingDelay = 0;
+        kick();
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    uint8_t PioTransport<bit_mode, ring_size_bits>::read()
+    {
+        return 0;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    void PioTransport<bit_mode, ring_size_bits>::delay(uint32_t us)
+    {
+        pendingDelay += us;
+        if (pendingDelay > MAX_DELAY_US)
+            sync(); // longer than the state machine can wait on its own, sync waits the whole delay on the CPU
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    void PioTransport<bit_mode, ring_size_bits>::sync()
+    {
+        while (queuedWords() || dma_channel_is_busy(dmaChannel))
+        {
+            kick();
+            tight_loop_contents();
+        }
+
+        // the last word has left the FIFO once the state machine stalls on the next pull
+        pio->fdebug = 1u << (PIO_FDEBUG_TXSTALL_LSB + sm);
+        while (!(pio->fdebug & (1u << (PIO_FDEBUG_TXSTALL_LSB + sm))))
+            tight_loop_contents();
+
+        sleep_us(pendingDelay);
+        pendingDelay = 0;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    void PioTransport<bit_mode, ring_size_bits>::commit()
+    {
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    uint64_t PioTransport<bit_mode, ring_size_bits>::now() const
+    {
+        uint64_t time = time_us_64();
+        return queueEnd_us > time ? queueEnd_us : time;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    void PioTransport<bit_mode, ring_size_bits>::advanceQueueTime(uint8_t words)
+    {
+        queueEnd_us = now() + pendingDelay + words * WORD_TIME_US;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    void PioTransport<bit_mode, ring_size_bits>::dmaIrqHandler()
+    {
+        for (uint channel = 0; channel < NUM_DMA_CHANNELS; channel++)
+        {
+            if (instances[channel] && dma_channel_get_irq0_status(channel))
+            {
+                dma_channel_acknowledge_irq0(channel);
+                instances[channel]->kick();
+            }
+        }
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    void PioTransport<bit_mode, ring_size_bits>::push(uint32_t word)
+    {
+        while (queuedWords() >= RING_SIZE) // ring is full, wait for the DMA to free a slot
+        {
+            kick();
+            tight_loop_contents();
+        }
+
+        ring[head % RING_SIZE] = word;
+        head = head + 1;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    void PioTransport<bit_mode, ring_size_bits>::kick()
+    {
+        uint32_t interrupts = save_and_disable_interrupts();
+        if (!dma_channel_is_busy(dmaChannel) && dmaTail != head)
+        {
+            uint32_t count = head - dmaTail;
+            dma_channel_transfer_from_buffer_now(dmaChannel, &ring[dmaTail % RING_SIZE], count);
+            dmaTail = head;
+        }
+        restore_interrupts(interrupts);
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits>
+    uint32_t PioTransport<bit_mode, ring_size_bits>::queuedWords() const
+    {
+        // words handed to the DMA that it hasn't read yet are still queued,
+        // the interrupt handler must not start a new transfer in between the two reads
+        uint32_t interrupts = save_and_disable_interrupts();
+        uint32_t queued = head - dmaTail + dma_channel_hw_addr(dmaChannel)->transfer_count;
+        restore_interrupts(interrupts);
+        return queued;
+    }
+}
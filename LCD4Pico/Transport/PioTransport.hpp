@@ -0,0 +1,194 @@
+#pragma once
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/dma.h"
+#include "../Enums.hpp"
+#include "BitBangTransport.hpp"
+
+#ifndef PIO_TRANSPORT_CLOCK_HZ
+#define PIO_TRANSPORT_CLOCK_HZ 10000000 // one state machine cycle = 100 ns
+#endif
+
+namespace lcd4pico
+{
+    /**
+     * @brief Streams the bus transfers from a DMA ring buffer into a PIO state machine, which drives RS, E and the data pins.
+     *        Writes only queue pre-encoded words and return, the state machine also inserts the waiting times between
+     *        the transfers, so the CPU is free while e.g. a whole screen is sent.
+     *
+     *        The data pins have to be consecutive GPIOs (D0 or D4 first), RS and E can be any other pins.
+     *        The busy flag can't be read through this transport, if an RW pin is given it is just held low.
+     *
+     * @tparam ring_size_bits The ring buffer holds 2^ring_size_bits words (one word per nibble in 4bit mode).
+     */
+    template <const Bit_Mode bit_mode, const uint8_t ring_size_bits = 8>
+    class PioTransport
+    {
+    public:
+        static constexpr uint32_t RING_SIZE = 1u << ring_size_bits;
+        static constexpr uint32_t MAX_DELAY_US = 0x10000;
+        static constexpr uint32_t WORD_TIME_US = 2; // upper bound for one word without its delay
+
+        /**
+         * @brief The state machine program (`.side_set 1`, E is the side-set pin):
+         *
+         *  0:     pull block        side 0         ; E low, wait for the next word
+         *  1:     out x, 16         side 0
+         *  2:     jmp x-- 2         side 0 [9]     ; wait (x + 1) us
+         *  3:     out y, 1          side 0         ; RS
+         *  4:     jmp !y 7          side 0
+         *  5:     set pins, 1       side 0
+         *  6:     jmp 8             side 0
+         *  7:     set pins, 0       side 0
+         *  8:     out pins, <bits>  side 1 [4]     ; data together with E high for 500 ns
+         */
+        static constexpr uint16_t PROGRAM_INSTRUCTIONS[] = {
+            0x80a0,
+            0x6030,
+            0x0942,
+            0x6041,
+            0x0067,
+            0xe001,
+            0x0008,
+            0xe000,
+            (uint16_t)(0x7400 | bit_mode)};
+
+        const uint8_t ENABLEPIN;
+        const uint8_t RSPIN;
+        const uint8_t RWPIN;
+        const uint8_t FIRSTDATAPIN;
+
+        /**
+         * @brief Construct a new object.
+         *
+         * @param First_Data_Pin GPIO of D0 (8bit mode) or D4 (4bit mode), the other data pins follow consecutively.
+         */
+        PioTransport(PIO pio,
+                     uint8_t Enable_Pin,
+                     uint8_t RS_Pin,
+                     uint8_t RW_Pin,
+                     uint8_t First_Data_Pin);
+
+        /**
+         * @brief Construct a new object without the RW pin.
+         *
+         * @param First_Data_Pin GPIO of D0 (8bit mode) or D4 (4bit mode), the other data pins follow consecutively.
+         */
+        PioTransport(PIO pio,
+                     uint8_t Enable_Pin,
+                     uint8_t RS_Pin,
+                     uint8_t First_Data_Pin);
+
+        /**
+         * @brief Copies only the pins; the copy claims a state machine and a DMA channel of its own in `init`,
+         *        so the interrupt handler never refers to a moved-from object.
+         *
+         */
+        PioTransport(const PioTransport &other);
+
+        PioTransport &operator=(const PioTransport &) = delete;
+
+        ~PioTransport();
+
+        /**
+         * @brief Encodes one transfer into a state machine word.
+         *
+         * @param reg `INSTRUCTION_REGISTER` or `DATA_REGISTER`.
+         * @param value Nibble (4bit mode) or byte (8bit mode).
+         * @param delay_us How long the bus stays idle before this transfer (at least 1 us).
+         */
+        static constexpr uint32_t encode(bool reg, uint8_t value, uint32_t delay_us)
+        {
+            uint32_t loops = delay_us ? delay_us - 1 : 0;
+            return (loops & 0xFFFF) | (uint32_t)reg << 16 | (uint32_t)value << 17;
+        }
+
+        /**
+         * @brief Loads the program, claims a state machine and a DMA channel and initializes the pins.
+         *
+         */
+        void init();
+
+        bool canRead() const;
+
+        void setRegister(bool reg);
+
+        /**
+         * @brief Queues a whole byte for the selected register (two words in 4bit mode).
+         *
+         */
+        void write(uint8_t data);
+
+        /**
+         * @brief Queues only the upper nibble of `data` (4bit mode only, used during the initialization).
+         *
+         */
+        void writeUpperNibble(uint8_t data);
+
+        /**
+         * @brief Reading is not supported, always returns 0.
+         *
+         */
+        uint8_t read();
+
+        /**
+         * @brief The state machine waits at least `us` microseconds before it sends the next transfer.
+         *        Delays longer than `MAX_DELAY_US` are waited on the CPU after the queue is empty.
+         *
+         */
+        void delay(uint32_t us);
+
+        /**
+         * @brief Blocks until every queued transfer is on the bus.
+         *
+         */
+        void sync();
+
+        /**
+         * @brief Nothing to do, the state machine starts with a transfer as soon as it is queued.
+         *
+         */
+        void commit();
+
+        /**
+         * @brief The time in microseconds at which the last queued transfer will be on the bus, or the current time
+         *        if the queue is already empty. Overestimates rather than underestimates, so delays derived from it are safe.
+         *
+         */
+        uint64_t now() const;
+
+    private:
+        PIO pio;
+        uint sm = 0;
+        int dmaChannel = -1;
+
+        alignas(RING_SIZE * sizeof(uint32_t)) uint32_t ring[RING_SIZE];
+        volatile uint32_t head = 0;     // number of words written to the ring
+        volatile uint32_t dmaTail = 0;  // number of words handed to the DMA
+        uint32_t pendingDelay = 0;
+        uint64_t queueEnd_us = 0;
+        bool registerSelect = INSTRUCTION_REGISTER;
+
+        static PioTransport *instances[NUM_DMA_CHANNELS];
+
+        static void dmaIrqHandler();
+
+        void push(uint32_t word);
+
+        /**
+         * @brief Moves the estimated end of the queue past `words` words and the pending delay.
+         *
+         */
+        void advanceQueueTime(uint8_t words);
+
+        /**
+         * @brief Starts a DMA transfer for all words that were written since the last one, if the channel is idle.
+         *
+         */
+        void kick();
+
+        uint32_t queuedWords() const;
+    };
+}
+
+#include "PioTransport.cpp"
@@ -0,0 +1,184 @@
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "../Enums.hpp"
+#include "QueuedTransport.hpp"
+
+namespace lcd4pico
+{
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits>
+    QueuedTransport<bit_mode, queue_size_bits>::QueuedTransport(uint8_t Enable_Pin,
+                                                                uint8_t RS_Pin,
+                                                                const uint8_t (&Data_Pins)[bit_mode],
+                                                                QueueFullPolicy policy) :
+
+                                                                                          pins(Enable_Pin, RS_Pin, Data_Pins),
+                                                                                          policy(policy)
+    {
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits>
+    QueuedTransport<bit_mode, queue_size_bits>::QueuedTransport(uint8_t Enable_Pin,
+                                                                uint8_t RS_Pin,
+                                                                uint8_t RW_Pin,
+                                                                const uint8_t (&Data_Pins)[bit_mode],
+                                                                QueueFullPolicy policy) :
+
+                                                                                          pins(Enable_Pin, RS_Pin, RW_Pin, Data_Pins),
+                                                                                          policy(policy)
+    {
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits>
+    void QueuedTransport<bit_mode, queue_size_bits>::init()
+    {
+        pins.init();
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits>
+    bool QueuedTransport<bit_mode, queue_size_bits>::canRead() const
+    {
+        return false;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits>
+    void QueuedTransport<bit_mode, queue_size_bits>::setRegister(bool reg)
+    {
+        registerSelect = reg;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits>
+    void QueuedTransport<bit_mode, queue_size_bits>::write(uint8_t data)
+    {
+        enqueue(data | (registerSelect ? DATA_FLAG : 0));
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits>
+    void QueuedTransport<bit_mode, queue_size_bits>::writeUpperNibble(uint8_t data)
+    {
+        enqueue(data | (registerSelect ? DATA_FLAG : 0) | NIBBLE_FLAG);
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits>
+    uint8_t QueuedTransport<bit_mode, queue_size_bits>::read()
+    {
+        return 0;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits>
+    void QueuedTransport<bit_mode, queue_size_bits>::delay(uint32_t us)
+    {
+        pendingDelay += us;
+        if (pendingDelay > MAX_DELAY_US)
+            sync(); // longer than a transfer can carry, sync waits the whole delay on the CPU
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits>
+    void QueuedTransport<bit_mode, queue_size_bits>::sync()
+    {
+        while (queued())
+            wait();
+
+        sleep_us(pendingDelay);
+        pendingDelay = 0;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits>
+    void QueuedTransport<bit_mode, queue_size_bits>::commit()
+    {
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits>
+    uint64_t QueuedTransport<bit_mode, queue_size_bits>::now() const
+    {
+        uint64_t time = time_us_64();
+        return queueEnd_us > time ? queueEnd_us : time;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits>
+    void QueuedTransport<bit_mode, queue_size_bits>::setDrainedCallback(void (*callback)(void *context), void *context)
+    {
+        drainedCallback = callback;
+        drainedContext = context;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits>
+    uint32_t QueuedTransport<bit_mode, queue_size_bits>::queued() const
+    {
+        return head - tail;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits>
+    uint32_t QueuedTransport<bit_mode, queue_size_bits>::dropped() const
+    {
+        return droppedTransfers;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits>
+    int64_t QueuedTransport<bit_mode, queue_size_bits>::service()
+    {
+        while (tail != head)
+        {
+            uint32_t transfer = queue[tail % QUEUE_SIZE];
+            uint64_t due = lastTransfer_us + (transfer >> 16);
+            uint64_t time = time_us_64();
+            if (time < due)
+                return due - time;
+
+            pins.setRegister(transfer & DATA_FLAG);
+            if (transfer & NIBBLE_FLAG)
+                pins.writeUpperNibble(transfer & 0xFF);
+            else
+                pins.write(transfer & 0xFF);
+            lastTransfer_us = time_us_64();
+            tail = tail + 1;
+        }
+
+        alarmActive = false;
+        if (drainedCallback)
+            drainedCallback(drainedContext);
+        return 0;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits>
+    int64_t QueuedTransport<bit_mode, queue_size_bits>::alarmCallback(alarm_id_t id, void *transport)
+    {
+        (void)id;
+        return static_cast<QueuedTransport *>(transport)->service();
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits>
+    void QueuedTransport<bit_mode, queue_size_bits>::enqueue(uint32_t transfer)
+    {
+        while (queued() >= QUEUE_SIZE)
+        {
+            if (policy == QueueFullPolicy::Drop)
+            {
+                droppedTransfers++;
+                return;
+            }
+            wait(); // the alarm frees a slot
+        }
+
+        queueEnd_us = now() + pendingDelay + TRANSFER_TIME_US;
+        queue[head % QUEUE_SIZE] = transfer | pendingDelay << 16;
+        head = head + 1;
+        pendingDelay = 0;
+
+        uint32_t interrupts = save_and_disable_interrupts();
+        if (!alarmActive)
+        {
+            alarmActive = true;
+            if (add_alarm_in_us(1, alarmCallback, this, true) < 0)
+                alarmActive = false; // no free alarm slot, the queue is sent by `wait` or with the next write
+        }
+        restore_interrupts(interrupts);
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits>
+    void QueuedTransport<bit_mode, queue_size_bits>::wait()
+    {
+        if (!alarmActive)
+            service();
+        tight_loop_contents();
+    }
+}
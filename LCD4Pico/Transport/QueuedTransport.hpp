@@ -0,0 +1,154 @@
+#pragma once
+#include "pico/stdlib.h"
+#include "../Enums.hpp"
+#include "BitBangTransport.hpp"
+
+namespace lcd4pico
+{
+    /**
+     * @brief Queues the transfers in a ring buffer and returns immediately, a timer alarm sends them in the background,
+     *        keeping the waiting times between them. Even a clear display doesn't block the caller.
+     *        The pins are driven like with `BitBangTransport`, the busy flag can't be read.
+     *
+     *        Only use the display from the core that called `setup`, the alarm fires on that core.
+     *
+     * @tparam queue_size_bits The queue holds 2^queue_size_bits transfers (bytes).
+     */
+    template <const Bit_Mode bit_mode, const uint8_t queue_size_bits = 7>
+    class QueuedTransport
+    {
+    public:
+        static constexpr uint32_t QUEUE_SIZE = 1u << queue_size_bits;
+        static constexpr uint32_t MAX_DELAY_US = 0xFFFF;
+        static constexpr uint32_t TRANSFER_TIME_US = 4; // upper bound for one transfer without its delay
+
+        /**
+         * @brief Construct a new object.
+         *
+         * @param Data_Pins Data pins order: (D0,D1,D2,D3,) D4,D5,D6,D7 .
+         * @param policy What a write does when the queue is full. `Drop` never blocks, but the display's content
+         *               and cursor are unknown after a dropped transfer.
+         */
+        QueuedTransport(uint8_t Enable_Pin,
+                        uint8_t RS_Pin,
+                        const uint8_t (&Data_Pins)[bit_mode],
+                        QueueFullPolicy policy = QueueFullPolicy::Block);
+
+        /**
+         * @brief Construct a new object, the RW pin is held low.
+         *
+         */
+        QueuedTransport(uint8_t Enable_Pin,
+                        uint8_t RS_Pin,
+                        uint8_t RW_Pin,
+                        const uint8_t (&Data_Pins)[bit_mode],
+                        QueueFullPolicy policy = QueueFullPolicy::Block);
+
+        void init();
+
+        bool canRead() const;
+
+        void setRegister(bool reg);
+
+        /**
+         * @brief Queues a whole byte for the selected register.
+         *
+         */
+        void write(uint8_t data);
+
+        /**
+         * @brief Queues only the upper nibble of `data` (4bit mode only, used during the initialization).
+         *
+         */
+        void writeUpperNibble(uint8_t data);
+
+        /**
+         * @brief Reading is not supported, always returns 0.
+         *
+         */
+        uint8_t read();
+
+        /**
+         * @brief The next queued transfer is sent at least `us` microseconds after the previous one.
+         *        Delays longer than `MAX_DELAY_US` are waited on the CPU after the queue is empty.
+         *
+         */
+        void delay(uint32_t us);
+
+        /**
+         * @brief Blocks until every queued transfer is on the bus.
+         *
+         */
+        void sync();
+
+        /**
+         * @brief Nothing to do, the alarm starts with a transfer as soon as it is queued.
+         *
+         */
+        void commit();
+
+        /**
+         * @brief The estimated time at which the last queued transfer will be on the bus, or the current time if the queue is empty.
+         *
+         */
+        uint64_t now() const;
+
+        /**
+         * @brief Sets a function that is called (from the alarm interrupt) every time the queue runs empty.
+         *
+         */
+        void setDrainedCallback(void (*callback)(void *context), void *context = nullptr);
+
+        /**
+         * @brief Number of transfers that are still queued.
+         *
+         */
+        uint32_t queued() const;
+
+        /**
+         * @brief Number of transfers discarded because the queue was full (`QueueFullPolicy::Drop`).
+         *
+         */
+        uint32_t dropped() const;
+
+        /**
+         * @brief Sends every transfer that is due. Called by the alarm, but can also be called directly, e.g. when polling.
+         *
+         * @return Microseconds until the next transfer is due, 0 if the queue is empty.
+         */
+        int64_t service();
+
+    private:
+        // a transfer: data in bits 0-7, RS in bit 8, only the upper nibble in bit 9, delay in bits 16-31
+        static constexpr uint32_t DATA_FLAG = 1u << 8;
+        static constexpr uint32_t NIBBLE_FLAG = 1u << 9;
+
+        BitBangTransport<bit_mode> pins;
+        const QueueFullPolicy policy;
+
+        uint32_t queue[QUEUE_SIZE];
+        volatile uint32_t head = 0; // written by the caller
+        volatile uint32_t tail = 0; // written by the alarm
+        volatile bool alarmActive = false;
+        uint32_t droppedTransfers = 0;
+        bool registerSelect = INSTRUCTION_REGISTER;
+        uint32_t pendingDelay = 0;
+        uint64_t queueEnd_us = 0;
+        uint64_t lastTransfer_us = 0;
+
+        void (*drainedCallback)(void *context) = nullptr;
+        void *drainedContext = nullptr;
+
+        static int64_t alarmCallback(alarm_id_t id, void *transport);
+
+        void enqueue(uint32_t transfer);
+
+        /**
+         * @brief One step of waiting for the alarm; sends the due transfers itself if no alarm could be scheduled.
+         *
+         */
+        void wait();
+    };
+}
+
+#include "QueuedTransport.cpp"
@@ -0,0 +1,306 @@
+#include "pico/stdlib.h"
+#include "../Enums.hpp"
+#include "SharedBusTransport.hpp"
+
+namespace lcd4pico
+{
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    SharedBus<bit_mode, panels>::SharedBus(uint8_t RS_Pin,
+                                           uint8_t RW_Pin,
+                                           const uint8_t (&Data_Pins)[bit_mode],
+                                           const uint8_t (&Enable_Pins)[panels]) :
+
+                                                                                   RSPIN(RS_Pin),
+                                                                                   RWPIN(RW_Pin),
+                                                                                   DATAPINS(Data_Pins),
+                                                                                   ENABLEPINS(Enable_Pins)
+    {
+        buildDataPinTable();
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    SharedBus<bit_mode, panels>::SharedBus(uint8_t RS_Pin,
+                                           const uint8_t (&Data_Pins)[bit_mode],
+                                           const uint8_t (&Enable_Pins)[panels]) :
+
+                                                                                   RSPIN(RS_Pin),
+                                                                                   RWPIN(WRITE_ONLY),
+                                                                                   DATAPINS(Data_Pins),
+                                                                                   ENABLEPINS(Enable_Pins)
+    {
+        buildDataPinTable();
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    void SharedBus<bit_mode, panels>::buildDataPinTable()
+    {
+        for (uint8_t panel = 0; panel < panels; panel++)
+        {
+            enablePinMasks[panel] = 1u << ENABLEPINS[panel];
+            allEnablePinsMask |= enablePinMasks[panel];
+        }
+
+        for (uint8_t pin : DATAPINS)
+            dataPinMask |= 1u << pin;
+
+        for (uint16_t value = 0; value < (1 << bit_mode); value++)
+        {
+            dataPinValues[value] = 0;
+            for (uint8_t pin = 0; pin < bit_mode; pin++)
+            {
+                if (value & (1 << pin))
+                    dataPinValues[value] |= 1u << DATAPINS[pin];
+            }
+        }
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    void SharedBus<bit_mode, panels>::init()
+    {
+        if (isInitialized)
+            return;
+
+        for (uint8_t pin : ENABLEPINS)
+        {
+            gpio_init(pin);
+            gpio_set_dir(pin, GPIO_OUT);
+        }
+        gpio_put_masked(allEnablePinsMask, 0);
+
+        gpio_init(RSPIN);
+        gpio_set_dir(RSPIN, GPIO_OUT);
+        gpio_put(RSPIN, registerSelect);
+        if (RWPIN != WRITE_ONLY)
+        {
+            gpio_init(RWPIN);
+            gpio_set_dir(RWPIN, GPIO_OUT);
+        }
+        for (uint8_t pin : DATAPINS)
+            gpio_init(pin); // only here, switching the direction later doesn't touch the pin functions
+        writeMode(); // the data pins have to be set up before the first transfer, that may be a read
+        isInitialized = true;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    bool SharedBus<bit_mode, panels>::canRead() const
+    {
+        return RWPIN != WRITE_ONLY;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    void SharedBus<bit_mode, panels>::write(uint32_t panelMask, bool reg, uint8_t data, bool upperNibbleOnly)
+    {
+        if (muted)
+            return;
+
+        uint32_t enablePinMask = allEnablePinsMask;
+        if (!broadcasting)
+        {
+            enablePinMask = 0;
+            for (uint8_t panel = 0; panel < panels; panel++)
+            {
+                if (panelMask & (1u << panel))
+                    enablePinMask |= enablePinMasks[panel];
+            }
+        }
+
+        writeMode();
+        setRegister(reg);
+
+        if (bit_mode == _8BIT)
+            strobeData(enablePinMask, data);
+        else
+        {
+            strobeData(enablePinMask, data >> 4);
+            if (!upperNibbleOnly)
+                strobeData(enablePinMask, data & 0xF);
+        }
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    uint8_t SharedBus<bit_mode, panels>::read(uint32_t panelMask, bool reg)
+    {
+        if (muted || RWPIN == WRITE_ONLY)
+            return 0;
+        if (broadcasting)
+            panelMask = (1ull << panels) - 1;
+
+        readMode();
+        setRegister(reg);
+
+        // only one display may drive the data lines at a time
+        uint8_t data = 0;
+        for (uint8_t panel = 0; panel < panels; panel++)
+        {
+            if (panelMask & (1u << panel))
+                data |= readFrom(enablePinMasks[panel]);
+        }
+        return data;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    bool SharedBus<bit_mode, panels>::isMuted() const
+    {
+        return muted;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    bool SharedBus<bit_mode, panels>::isBroadcasting() const
+    {
+        return broadcasting;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    void SharedBus<bit_mode, panels>::beginBroadcast()
+    {
+        broadcasting = true;
+        muted = false;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    void SharedBus<bit_mode, panels>::muteBroadcast()
+    {
+        if (broadcasting)
+            muted = true;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    void SharedBus<bit_mode, panels>::endBroadcast()
+    {
+        broadcasting = false;
+        muted = false;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    void SharedBus<bit_mode, panels>::readMode()
+    {
+        if (!isInWriteMode)
+            return;
+        gpio_set_dir_in_masked(dataPinMask); // release the data pins before the display drives them
+        gpio_put(RWPIN, 1);
+        isInWriteMode = false;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    void SharedBus<bit_mode, panels>::writeMode()
+    {
+        if (isInWriteMode)
+            return;
+        if (RWPIN != WRITE_ONLY)
+            gpio_put(RWPIN, 0);
+        gpio_set_dir_out_masked(dataPinMask);
+        isInWriteMode = true;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    void SharedBus<bit_mode, panels>::setRegister(bool reg)
+    {
+        if (reg == registerSelect)
+            return;
+        gpio_put(RSPIN, reg);
+        registerSelect = reg;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    uint8_t SharedBus<bit_mode, panels>::readFrom(uint32_t enablePinMask)
+    {
+        uint8_t data = 0;
+        for (uint8_t nibble = 0; nibble < (bit_mode == _4BIT ? 2 : 1); nibble++)
+        {
+            gpio_put_masked(enablePinMask, enablePinMask);
+            busy_wait_us_32(1);
+
+            uint32_t pins = gpio_get_all();
+            data <<= 4;
+            for (uint8_t pin = 0; pin < bit_mode; pin++)
+            {
+                uint8_t bit = (pins >> DATAPINS[pin]) & 1;
+                data |= bit << pin;
+            }
+
+            gpio_put_masked(enablePinMask, 0);
+            busy_wait_us_32(1);
+        }
+        return data;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    void SharedBus<bit_mode, panels>::strobeData(uint32_t enablePinMask, uint8_t value)
+    {
+        // RS is already stable here, so the data may change together with the rising edge of E
+        gpio_put_masked(dataPinMask | enablePinMask, dataPinValues[value] | enablePinMask);
+        busy_wait_us_32(1); // a 1us sleep would cost more than the pulse itself
+        gpio_put_masked(enablePinMask, 0);
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    PanelTransport<bit_mode, panels>::PanelTransport(SharedBus<bit_mode, panels> &bus, uint8_t panel) : sharedBus(&bus),
+                                                                                                       PANEL(panel)
+    {
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    void PanelTransport<bit_mode, panels>::init()
+    {
+        sharedBus->init();
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    bool PanelTransport<bit_mode, panels>::canRead() const
+    {
+        return sharedBus->canRead();
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    bool PanelTransport<bit_mode, panels>::canProbe() const
+    {
+        return !sharedBus->isBroadcasting();
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    void PanelTransport<bit_mode, panels>::setRegister(bool reg)
+    {
+        registerSelect = reg;
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    void PanelTransport<bit_mode, panels>::write(uint8_t data)
+    {
+        sharedBus->write(1u << PANEL, registerSelect, data, false);
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    void PanelTransport<bit_mode, panels>::writeUpperNibble(uint8_t data)
+    {
+        sharedBus->write(1u << PANEL, registerSelect, data, true);
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    uint8_t PanelTransport<bit_mode, panels>::read()
+    {
+        return sharedBus->read(1u << PANEL, registerSelect);
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    void PanelTransport<bit_mode, panels>::delay(uint32_t us)
+    {
+        if (!sharedBus->isMuted())
+            sleep_us(us);
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    void PanelTransport<bit_mode, panels>::sync()
+    {
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    void PanelTransport<bit_mode, panels>::commit()
+    {
+    }
+
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    uint64_t PanelTransport<bit_mode, panels>::now() const
+    {
+        return time_us_64();
+    }
+}
@@ -0,0 +1,167 @@
+#pragma once
+#include "pico/stdlib.h"
+#include "../Enums.hpp"
+#include "BitBangTransport.hpp"
+
+namespace lcd4pico
+{
+    /**
+     * @brief Data, RS and RW lines shared by several displays, each display has its own enable pin.
+     *        Only the displays whose enable pin is strobed take part in a transfer, so the other ones just ignore the bus.
+     *
+     *        While broadcasting, every transfer strobes all enable pins at once.
+     *
+     * @tparam panels Number of displays on the bus (up to 32).
+     */
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    class SharedBus
+    {
+        static_assert(panels <= 32, "the enable pins of the displays are kept in a 32bit mask");
+
+    private:
+        bool isInitialized = false;
+        bool isInWriteMode = false;
+        bool registerSelect = INSTRUCTION_REGISTER;
+        bool broadcasting = false;
+        bool muted = false;
+
+        uint32_t enablePinMasks[panels];
+        uint32_t allEnablePinsMask = 0;
+        uint32_t dataPinMask = 0;
+        uint32_t dataPinValues[1 << bit_mode]; // GPIO output values for every possible nibble/byte
+
+    public:
+        const uint8_t RSPIN;
+        const uint8_t RWPIN;
+        const uint8_t (&DATAPINS)[bit_mode];
+        const uint8_t (&ENABLEPINS)[panels];
+
+        /**
+         * @brief Construct a new object.
+         *
+         * @param Data_Pins Data pins order: (D0,D1,D2,D3,) D4,D5,D6,D7 .
+         * @param Enable_Pins Enable pin of every display.
+         */
+        SharedBus(uint8_t RS_Pin,
+                  uint8_t RW_Pin,
+                  const uint8_t (&Data_Pins)[bit_mode],
+                  const uint8_t (&Enable_Pins)[panels]);
+
+        /**
+         * @brief Construct a new object without the RW pin (write only mode; not recommended).
+         *
+         */
+        SharedBus(uint8_t RS_Pin,
+                  const uint8_t (&Data_Pins)[bit_mode],
+                  const uint8_t (&Enable_Pins)[panels]);
+
+        /**
+         * @brief Initializes all pins of the bus, only the first call does anything.
+         *
+         */
+        void init();
+
+        bool canRead() const;
+
+        /**
+         * @brief Writes a byte (or only its upper nibble) to the displays in `panelMask`.
+         *
+         */
+        void write(uint32_t panelMask, bool reg, uint8_t data, bool upperNibbleOnly);
+
+        /**
+         * @brief Reads a byte from the displays in `panelMask`, one after another.
+         *        If there is more than one, the busy flags are combined, i.e. the result is busy if any display is busy.
+         *
+         */
+        uint8_t read(uint32_t panelMask, bool reg);
+
+        /**
+         * @brief Whether waiting for the bus makes sense, it doesn't while the broadcast is muted.
+         *
+         */
+        bool isMuted() const;
+
+        bool isBroadcasting() const;
+
+        /**
+         * @brief Starts a broadcast: the transfers of the next display go to all displays.
+         *
+         */
+        void beginBroadcast();
+
+        /**
+         * @brief Mutes the rest of the broadcast: the transfers of the other displays only update their state, nothing is sent.
+         *
+         */
+        void muteBroadcast();
+
+        void endBroadcast();
+
+    private:
+        void buildDataPinTable();
+
+        void readMode();
+
+        void writeMode();
+
+        void setRegister(bool reg);
+
+        uint8_t readFrom(uint32_t enablePinMask);
+
+        void strobeData(uint32_t enablePinMask, uint8_t value);
+    };
+
+    /**
+     * @brief Transport of one display on a `SharedBus`.
+     *
+     *        SharedBus<_4BIT, 2> bus(RS, RW, dataPins, enablePins);
+     *        LCD4Pico<_4BIT, PanelTransport<_4BIT, 2>> left(PanelTransport<_4BIT, 2>(bus, 0));
+     *
+     */
+    template <const Bit_Mode bit_mode, const uint8_t panels>
+    class PanelTransport
+    {
+    private:
+        SharedBus<bit_mode, panels> *sharedBus;
+        bool registerSelect = INSTRUCTION_REGISTER;
+
+    public:
+        const uint8_t PANEL;
+
+        PanelTransport(SharedBus<bit_mode, panels> &bus, uint8_t panel);
+
+        void init();
+
+        bool canRead() const;
+
+        /**
+         * @brief False while broadcasting: the reads of all displays are combined, so a warm start can't be detected
+         *        and every display takes the reset sequence.
+         *
+         */
+        bool canProbe() const;
+
+        /**
+         * @brief Only remembers the register, the RS line is set right before each transfer because other displays use it too.
+         *
+         */
+        void setRegister(bool reg);
+
+        void write(uint8_t data);
+
+        void writeUpperNibble(uint8_t data);
+
+        uint8_t read();
+
+        void delay(uint32_t us);
+
+        void sync();
+
+        void commit();
+
+        uint64_t now() const;
+    };
+}
+
+#include "SharedBusTransport.cpp"
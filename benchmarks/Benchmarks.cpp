@@ -0,0 +1,12 @@
+#include "LCD4Pico/LCD4Pico.hpp"
+#include "LCD4Pico/Host/Benchmark.hpp"
+
+// Prints the standard workloads and the GPIO writes per byte as CSV, diff the output between versions.
+// Fails if a workload violates the display timing.
+int main()
+{
+    uint64_t violations = lcd4pico::host::runStandardBenchmarks(stdout);
+    printf("\n");
+    lcd4pico::host::runGpioBenchmarks(stdout);
+    return violations ? 1 : 0;
+}
@@ -0,0 +1,67 @@
+#include "LCD4Pico/LCD4Pico.hpp"
+#include "LCD4Pico/Host/HD44780.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+static const uint8_t dpins[] = {4, 5, 6, 7};
+
+// a display that is slower than the datasheet and than the default waiting times
+static void slowDown(host::HD44780 &display)
+{
+    display.timing.instruction_ns = 80000;
+    display.timing.clearOrHome_ns = 3000000;
+}
+
+int main()
+{
+    TimingProfile profile;
+
+    // measured with the busy flag: at least the execution time, at most the margin and a few polls more
+    {
+        host::hal().reset();
+        host::HD44780 display(16, 18, 17, dpins);
+        slowDown(display);
+        LCD4Pico<_4BIT> lcd(16, 18, 17, dpins);
+        lcd.setup();
+        lcd.write("Hi");
+        lcd.shiftDisplay(Direction::Left);
+        display.violations.clear(); // only the calibration is checked here, the reset sequence polls with the datasheet limits
+
+        CHECK(lcd.calibrate(profile, 20));
+        CHECK(profile.instruction_us >= 80);
+        CHECK(profile.instruction_us <= 80 * 120 / 100 + 20);
+        CHECK(profile.dataWrite_us >= 80);
+        CHECK(profile.dataWrite_us <= 80 * 120 / 100 + 20);
+        CHECK(profile.clearOrHome_us >= 3000);
+        CHECK(profile.clearOrHome_us <= 3000 * 120 / 100 + 20);
+
+        // the content is kept, the cursor is home and the shift is reset
+        CHECK_EQUAL(display.ddram(0), 'H');
+        CHECK_EQUAL(display.ddram(1), 'i');
+        CHECK_EQUAL(display.addressCounter(), 0);
+        CHECK_EQUAL(display.displayShift(), 0);
+        lcd.write("J");
+        CHECK_EQUAL(display.ddram(0), 'J');
+        CHECK(display.violations.empty());
+    }
+
+    // the profile keeps a write only board within the execution times of the slow display, the default one doesn't
+    for (bool calibrated : {true, false})
+    {
+        host::hal().reset();
+        host::HD44780 display(16, 18, 17, dpins);
+        slowDown(display);
+        LCD4Pico<_4BIT> lcd(16, 18, dpins);
+        if (calibrated)
+            lcd.setTimingProfile(profile);
+        lcd.setup();
+        lcd.write("Hello");
+        lcd.clearDisplay();
+        lcd.write("World");
+        CHECK_EQUAL(display.violations.empty(), calibrated);
+        if (calibrated)
+            CHECK(display.render(16, 2).rfind("World", 0) == 0);
+    }
+    return test::checkResult();
+}
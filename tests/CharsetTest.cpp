@@ -0,0 +1,106 @@
+#include "LCD4Pico/LCD4Pico.hpp"
+#include "LCD4Pico/Host/HD44780.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+static const uint8_t dpins[] = {4, 5, 6, 7};
+
+// the single code of a code point, 0 if the ROM doesn't have it or needs two codes
+static uint8_t rom(Charset charset, char32_t codePoint)
+{
+    uint8_t codes[2];
+    return charset::toROM(charset, codePoint, codes) == 1 ? codes[0] : 0;
+}
+
+// decodes the first sequence of `bytes`, `length` is the number of bytes it took
+static char32_t decode(std::string_view bytes, size_t &length)
+{
+    length = 0;
+    return charset::decodeUtf8(bytes, length);
+}
+
+int main()
+{
+    // A00: ASCII without '\' and '~', katakana, some Greek and math symbols
+    CHECK_EQUAL(rom(Charset::A00, 'A'), 'A');
+    CHECK_EQUAL(rom(Charset::A00, 0x05), 0x05); // CGRAM
+    CHECK_EQUAL(rom(Charset::A00, '\\'), 0);
+    CHECK_EQUAL(rom(Charset::A00, '~'), 0);
+    CHECK_EQUAL(rom(Charset::A00, U'¥'), 0x5C);
+    CHECK_EQUAL(rom(Charset::A00, U'α'), 0xE0);
+    CHECK_EQUAL(rom(Charset::A00, U'β'), 0xE2);
+    CHECK_EQUAL(rom(Charset::A00, U'ß'), 0xE2);
+    CHECK_EQUAL(rom(Charset::A00, U'ε'), 0xE3);
+    CHECK_EQUAL(rom(Charset::A00, U'█'), 0xFF);
+    CHECK_EQUAL(rom(Charset::A00, U'ｱ'), 0xB1);
+    CHECK_EQUAL(rom(Charset::A00, U'€'), 0);
+    uint8_t codes[2];
+    CHECK_EQUAL(charset::toROM(Charset::A00, U'ガ', codes), 2);
+    CHECK_EQUAL(codes[0], 0xB6);
+    CHECK_EQUAL(codes[1], 0xDE);
+
+    // A02: ASCII, Latin-1, Cyrillic and Greek
+    CHECK_EQUAL(rom(Charset::A02, '\\'), '\\');
+    CHECK_EQUAL(rom(Charset::A02, '~'), '~');
+    CHECK_EQUAL(rom(Charset::A02, U'Ä'), 0xC4);
+    CHECK_EQUAL(rom(Charset::A02, U'ÿ'), 0xFF);
+    CHECK_EQUAL(rom(Charset::A02, U'α'), 0x90);
+    CHECK_EQUAL(rom(Charset::A02, U'β'), 0);
+    CHECK_EQUAL(rom(Charset::A02, U'Б'), 0x80);
+    CHECK_EQUAL(rom(Charset::A02, U'Я'), 0xAD);
+    CHECK_EQUAL(rom(Charset::A02, U'█'), 0);
+    CHECK_EQUAL(charset::toROM(Charset::A02, U'ガ', codes), 0);
+
+    CHECK(charset::findGlyph(U'€') != nullptr);
+    CHECK(charset::findGlyph(U'α') == nullptr);
+
+    // well formed UTF-8
+    size_t length;
+    CHECK_EQUAL(decode("A", length), U'A');
+    CHECK_EQUAL(length, 1);
+    CHECK_EQUAL(decode("\xC3\xA9", length), U'é');
+    CHECK_EQUAL(length, 2);
+    CHECK_EQUAL(decode("\xE2\x82\xAC", length), U'€');
+    CHECK_EQUAL(length, 3);
+    CHECK_EQUAL(decode("\xF0\x9F\x98\x80", length), 0x1F600);
+    CHECK_EQUAL(length, 4);
+    CHECK_EQUAL(decode("\xED\x9F\xBF", length), 0xD7FF);
+    CHECK_EQUAL(decode("\xF4\x8F\xBF\xBF", length), 0x10FFFF);
+
+    // malformed UTF-8: one byte is skipped
+    const char *malformed[] = {
+        "\xC0\xAF",         // overlong '/'
+        "\xE0\x80\xAF",     // overlong '/'
+        "\xF0\x80\x80\xAF", // overlong '/'
+        "\xE0\x9F\xBF",     // overlong U+07FF
+        "\xED\xA0\x80",     // surrogate U+D800
+        "\xED\xBF\xBF",     // surrogate U+DFFF
+        "\xF4\x90\x80\x80", // U+110000
+        "\xF8\x88\x80\x80", // invalid lead byte
+        "\x80",             // continuation byte
+        "\xE2\x82",         // truncated
+        "\xC3\x41"};        // missing continuation byte
+    for (const char *bytes : malformed)
+    {
+        CHECK_EQUAL(decode(bytes, length), charset::REPLACEMENT_CHARACTER);
+        CHECK_EQUAL(length, 1);
+    }
+
+    // on the display: α and β have their own codes on A00, a surrogate is written as the replacement
+    {
+        host::hal().reset();
+        host::HD44780 display(16, 18, 17, dpins);
+        LCD4Pico<_4BIT> lcd(16, 18, 17, dpins);
+        lcd.setup();
+        lcd.setCharset(Charset::A00);
+        lcd.write("αβ\xED\xA0\x80!");
+        CHECK_EQUAL(display.ddram(0), 0xE0);
+        CHECK_EQUAL(display.ddram(1), 0xE2);
+        CHECK_EQUAL(display.ddram(2), '?');
+        CHECK_EQUAL(display.ddram(3), '?');
+        CHECK_EQUAL(display.ddram(4), '?');
+        CHECK_EQUAL(display.ddram(5), '!');
+    }
+    return test::checkResult();
+}
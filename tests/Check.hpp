@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdio>
+
+// Checks for the host tests: a failed check prints its location and the test goes on, `main` returns `checkResult()`.
+#define CHECK(condition) lcd4pico::test::check(condition, #condition, __FILE__, __LINE__)
+#define CHECK_EQUAL(actual, expected) lcd4pico::test::checkEqual(actual, expected, #actual, __FILE__, __LINE__)
+
+namespace lcd4pico
+{
+    namespace test
+    {
+        inline int &failures()
+        {
+            static int count = 0;
+            return count;
+        }
+
+        inline void check(bool passed, const char *condition, const char *file, int line)
+        {
+            if (passed)
+                return;
+            fprintf(stderr, "%s:%d: check failed: %s\n", file, line, condition);
+            failures()++;
+        }
+
+        template <class A, class B>
+        void checkEqual(const A &actual, const B &expected, const char *expression, const char *file, int line)
+        {
+            if (actual == static_cast<A>(expected))
+                return;
+            fprintf(stderr, "%s:%d: %s is %lld, expected %lld\n", file, line, expression, (long long)actual, (long long)expected);
+            failures()++;
+        }
+
+        inline int checkResult()
+        {
+            if (failures())
+                fprintf(stderr, "%d check(s) failed\n", failures());
+            return failures() ? 1 : 0;
+        }
+    }
+}
@@ -0,0 +1,133 @@
+#include <string>
+#include "LCD4Pico/LCD4Pico.hpp"
+#include "LCD4Pico/Marquee/Marquee.hpp"
+#include "LCD4Pico/Host/HD44780.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+static const uint8_t dpins[] = {4, 5, 6, 7};
+
+// ticks the marquee until the display has been shifted `steps` times and the hidden cell is written
+template <class Marquee>
+static void runMarquee(Marquee &marquee, const host::HD44780 &display, uint32_t steps, uint8_t lineLength)
+{
+    uint32_t done = 0;
+    uint8_t start = display.displayShift();
+    uint8_t shift = start;
+    while (done < steps)
+    {
+        if (!marquee.tick())
+            sleep_us(50);
+        if (display.displayShift() != shift)
+        {
+            shift = display.displayShift();
+            done++;
+        }
+    }
+    for (uint8_t i = 0; i < 20; i++) // the cell after the last shift
+    {
+        if (!marquee.tick())
+            sleep_us(50);
+    }
+    CHECK_EQUAL(display.displayShift(), (start + steps) % lineLength);
+}
+
+static std::string window(const std::string &text, uint32_t period, uint32_t start, uint8_t columns)
+{
+    std::string visible;
+    for (uint8_t column = 0; column < columns; column++)
+    {
+        uint32_t position = (start + column) % period;
+        visible += position < text.size() ? text[position] : ' ';
+    }
+    return visible;
+}
+
+int main()
+{
+    // 1 line mode: the DDRAM line has 80 characters, the display shift wraps after 80 steps
+    {
+        host::hal().reset();
+        host::HD44780 display(16, 18, 17, dpins);
+        LCD4Pico<_4BIT, BitBangTransport<_4BIT>, Geometry16x1> lcd(16, 18, 17, dpins);
+        lcd.setup(1);
+        CHECK_EQUAL(lcd.lineLength(), 80);
+
+        for (uint8_t step = 0; step < 40; step++)
+            lcd.shiftDisplay(Direction::Left);
+        CHECK_EQUAL(display.displayShift(), 40);
+        CHECK_EQUAL(lcd.visiblePage(), decltype(lcd)::NO_PAGE);
+
+        lcd.showPage(1);
+        CHECK_EQUAL(display.displayShift(), 16);
+        CHECK_EQUAL(lcd.visiblePage(), 1);
+        lcd.showPage(0);
+        CHECK_EQUAL(display.displayShift(), 0);
+        CHECK_EQUAL(lcd.visiblePage(), 0);
+
+        // a text longer than the line is streamed into the hidden part
+        std::string text;
+        for (uint8_t i = 0; i < 100; i++)
+            text += (char)('A' + i % 26);
+        Marquee<decltype(lcd)> marquee(lcd);
+        marquee.start(text, 10000);
+        CHECK(display.render(16, 1) == window(text, 104, 0, 16));
+        runMarquee(marquee, display, 70, 80);
+        CHECK(display.render(16, 1) == window(text, 104, 70, 16));
+        runMarquee(marquee, display, 50, 80);
+        CHECK(display.render(16, 1) == window(text, 104, 120, 16));
+
+        // there is no second line to scroll
+        Marquee<decltype(lcd)> second(lcd, 1);
+        second.start("text", 10000);
+        CHECK(!second.isRunning());
+        CHECK(display.violations.empty());
+    }
+
+    // 2 line mode: the display shift wraps after 40 steps
+    {
+        host::hal().reset();
+        host::HD44780 display(16, 18, 17, dpins);
+        LCD4Pico<_4BIT> lcd(16, 18, 17, dpins);
+        lcd.setup(2);
+        CHECK_EQUAL(lcd.lineLength(), 40);
+
+        std::string text = "a text that is longer than one DDRAM line of 40 characters";
+        Marquee<decltype(lcd)> marquee(lcd, 1);
+        marquee.start(text, 10000);
+        runMarquee(marquee, display, 50, 40);
+        uint32_t period = text.size() + 4;
+        CHECK(display.render(16, 2) == std::string(16, ' ') + "\n" + window(text, period, 50, 16));
+        CHECK(display.violations.empty());
+    }
+
+    // a buffered clear display shows page 0 after the flush, like the unbuffered one
+    {
+        host::hal().reset();
+        host::HD44780 display(16, 18, 17, dpins);
+        LCD4Pico<_4BIT> lcd(16, 18, 17, dpins);
+        lcd.setup(2);
+        lcd.setBuffered(true);
+        lcd.showPage(1);
+        CHECK_EQUAL(display.displayShift(), 16);
+
+        lcd.clearDisplay();
+        lcd.writeLines("page", "zero");
+        lcd.flush();
+        CHECK_EQUAL(display.displayShift(), 0);
+        CHECK_EQUAL(lcd.visiblePage(), 0);
+        CHECK(display.render(16, 2) == "page            \nzero            ");
+
+        // without a shift the flush doesn't return home
+        display.recordTransfers = true;
+        lcd.clearDisplay();
+        lcd.write("x");
+        lcd.flush();
+        for (const host::Transfer &transfer : display.transfers)
+            CHECK(transfer.data || transfer.value != 0x02);
+        CHECK(display.render(16, 2) == "x               \n                ");
+        CHECK(display.violations.empty());
+    }
+    return test::checkResult();
+}
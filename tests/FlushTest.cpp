@@ -0,0 +1,134 @@
+#include "LCD4Pico/LCD4Pico.hpp"
+#include "LCD4Pico/Host/HD44780.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+static const uint8_t dpins[] = {4, 5, 6, 7};
+
+struct Counts
+{
+    uint64_t instructions;
+    uint64_t dataWrites;
+};
+
+static Counts sent(const host::HD44780 &display, const Counts &before)
+{
+    return {display.instructions - before.instructions, display.dataWrites - before.dataWrites};
+}
+
+static Counts counts(const host::HD44780 &display)
+{
+    return {display.instructions, display.dataWrites};
+}
+
+int main()
+{
+    // 2 line mode
+    {
+        host::HD44780 display(16, 18, 17, dpins);
+        LCD4Pico<Bit_Mode::_4BIT> lcd(16, 18, 17, dpins);
+        lcd.setup();
+        lcd.setBuffered(true);
+
+        // the first flush sends every DDRAM cell: two runs of 40 cells, a jump to the second line, the cursor back home
+        Counts before = counts(display);
+        lcd.writeLines("Hello,", "World!");
+        lcd.flush();
+        Counts first = sent(display, before);
+        CHECK_EQUAL(first.dataWrites, 80);
+        CHECK(first.instructions <= 3);
+        CHECK(display.render(16, 2) == "Hello,          \nWorld!          ");
+
+        // nothing changed, nothing but the cursor position is sent
+        before = counts(display);
+        lcd.flush();
+        CHECK_EQUAL(sent(display, before).dataWrites, 0);
+        CHECK(sent(display, before).instructions <= 1);
+
+        // one run of changed cells: a jump and the cells, the address counter ends where the cursor is
+        before = counts(display);
+        lcd.setCursor(0, 7);
+        lcd.write("abc");
+        lcd.flush();
+        CHECK_EQUAL(sent(display, before).dataWrites, 3);
+        CHECK_EQUAL(sent(display, before).instructions, 1);
+
+        // a gap of one unchanged cell is resent instead of jumping over it
+        before = counts(display);
+        lcd.setCursor(1, 7);
+        lcd.write("x");
+        lcd.setCursor(1, 9);
+        lcd.write("y");
+        lcd.flush();
+        CHECK_EQUAL(sent(display, before).dataWrites, 3);
+        CHECK_EQUAL(sent(display, before).instructions, 1);
+
+        // changes in both lines cost a jump per run
+        before = counts(display);
+        lcd.setCursor(0, 0);
+        lcd.write("1");
+        lcd.setCursor(1, 15);
+        lcd.write("2");
+        lcd.flush();
+        CHECK_EQUAL(sent(display, before).dataWrites, 2);
+        CHECK_EQUAL(sent(display, before).instructions, 2);
+        CHECK(display.render(16, 2) == "1ello, abc      \nWorld! x y     2");
+
+        // with the display shift on entry the flush writes the cells in place and restores the entry mode afterwards
+        lcd.setEntryMode(true, true);
+        before = counts(display);
+        uint8_t shift = display.displayShift();
+        lcd.setCursor(0, 1);
+        lcd.write("EL");
+        lcd.flush();
+        CHECK_EQUAL(sent(display, before).dataWrites, 2);
+        CHECK_EQUAL(sent(display, before).instructions, 3);
+        CHECK_EQUAL(display.displayShift(), shift);
+        CHECK(display.render(16, 2) == "1ELlo, abc      \nWorld! x y     2");
+
+        // the restored entry mode shifts the display again
+        lcd.setBuffered(false);
+        lcd.write("!");
+        CHECK_EQUAL(display.displayShift(), (shift + 1) % 40);
+
+        CHECK(display.violations.empty());
+    }
+
+    // 1 line mode: the DDRAM is one line of 80 cells, cells 40-79 are at 0x28-0x4F and not on a second line
+    {
+        host::hal().reset();
+        host::HD44780 display(16, 18, 17, dpins);
+        LCD4Pico<Bit_Mode::_4BIT, BitBangTransport<_4BIT>, Geometry16x1> lcd(16, 18, 17, dpins);
+        lcd.setup(1);
+        lcd.setBuffered(true);
+        lcd.write("abc");
+        lcd.moveCursorTo(0x28);
+        lcd.write("xyz");
+        lcd.moveCursorTo(0x4F);
+        lcd.write("12"); // wraps to 0x00 like the address counter
+        lcd.flush();
+        CHECK(display.render(16, 1) == "2bc             ");
+        CHECK_EQUAL(display.ddram(0x28), 'x');
+        CHECK_EQUAL(display.ddram(0x2A), 'z');
+        CHECK_EQUAL(display.ddram(0x4F), '1');
+
+        // a change at 0x28 is sent to 0x28, the cells at 0x00 are unchanged and not sent
+        Counts before = counts(display);
+        lcd.moveCursorTo(0x29);
+        lcd.write("Y");
+        lcd.flush();
+        CHECK_EQUAL(sent(display, before).dataWrites, 1);
+        CHECK_EQUAL(display.ddram(0x29), 'Y');
+        CHECK_EQUAL(display.ddram(0x01), 'b');
+
+        // clearing in buffered mode sets the entry mode to increment, like the instruction does
+        lcd.setEntryMode(false, false);
+        lcd.clearDisplay();
+        lcd.write("ok");
+        lcd.flush();
+        CHECK(display.render(16, 1) == "ok              ");
+        CHECK(display.violations.empty());
+    }
+    return test::checkResult();
+}
@@ -0,0 +1,97 @@
+#include "LCD4Pico/LCD4Pico.hpp"
+#include "LCD4Pico/Layout/Layout.hpp"
+#include "LCD4Pico/Host/HD44780.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+using LCD = LCD4Pico<_4BIT>;
+using Set = Gauges<LCD>;
+
+static const uint8_t dpins[] = {4, 5, 6, 7};
+
+// whether the cell at `address` shows the CGRAM glyph `pattern`
+static bool showsGlyph(const host::HD44780 &display, uint8_t address, const uint8_t (&pattern)[8])
+{
+    uint8_t code = display.ddram(address);
+    if (code >= 16)
+        return false;
+    for (uint8_t row = 0; row < 8; row++)
+    {
+        if (display.cgram((code & 7) * 8 + row) != pattern[row])
+            return false;
+    }
+    return true;
+}
+
+// a full cell is the ROM's full block on A00, a glyph on A02
+static bool showsFull(const host::HD44780 &display, uint8_t address, Charset charset)
+{
+    if (charset == Charset::A02)
+        return showsGlyph(display, address, Set::FULL_GLYPH);
+    return display.ddram(address) == 0xFF;
+}
+
+int main()
+{
+    for (Charset charset : {Charset::A00, Charset::A02})
+    {
+        host::hal().reset();
+        host::HD44780 display(16, 18, 17, dpins);
+        LCD lcd(16, 18, 17, dpins);
+        lcd.setup();
+        lcd.setCharset(charset);
+
+        Set gauges(lcd);
+        BarGraph<LCD, 4> bar(gauges, 0, 0);
+        LevelMeter<LCD, 2> level(gauges, 1, 6);
+        BigNumber<LCD, 1> number(gauges, 0, 12);
+
+        // 9 of 20 columns: a full cell, then 4 columns (3 on A02, where the full block takes that slot)
+        bar.set(9, 20);
+        CHECK(showsFull(display, 0x00, charset));
+        CHECK(showsGlyph(display, 0x01, charset == Charset::A02 ? Set::GLYPHS[Set::Columns3] : Set::GLYPHS[Set::Columns4]));
+        CHECK_EQUAL(display.ddram(0x02), ' ');
+        CHECK_EQUAL(display.ddram(0x03), ' ');
+
+        bar.set(20, 20);
+        for (uint8_t cell = 0; cell < 4; cell++)
+            CHECK(showsFull(display, cell, charset));
+
+        // 3 of 4 halves: the bottom cell full, the upper one half
+        level.set(3, 4);
+        CHECK(showsFull(display, 0x46, charset));
+        CHECK(showsGlyph(display, 0x06, Set::GLYPHS[Set::LowerHalf]));
+
+        // "1": top "UF ", bottom "LFL"
+        number.set(1);
+        CHECK(showsGlyph(display, 0x0C, Set::GLYPHS[Set::TopBar]));
+        CHECK(showsFull(display, 0x0D, charset));
+        CHECK_EQUAL(display.ddram(0x0E), ' ');
+        CHECK(showsGlyph(display, 0x4C, Set::GLYPHS[Set::BottomBar]));
+        CHECK(showsFull(display, 0x4D, charset));
+        CHECK(showsGlyph(display, 0x4E, Set::GLYPHS[Set::BottomBar]));
+
+        CHECK(display.violations.empty());
+    }
+
+    // a layout bar without the glyph set shows full cells, on A02 with a glyph
+    for (Charset charset : {Charset::A00, Charset::A02})
+    {
+        host::hal().reset();
+        host::HD44780 display(16, 18, 17, dpins);
+        LCD lcd(16, 18, 17, dpins);
+        lcd.setup();
+        lcd.setCharset(charset);
+
+        Layout<LCD, 1> layout(lcd);
+        uint8_t bar = layout.addBar(1, 0, 4);
+        layout.setBar(bar, 2, 4); // 10 of 20 columns
+        layout.update();
+        CHECK(showsFull(display, 0x40, charset));
+        CHECK(showsFull(display, 0x41, charset));
+        CHECK_EQUAL(display.ddram(0x42), ' ');
+        CHECK_EQUAL(display.ddram(0x43), ' ');
+    }
+    return test::checkResult();
+}
@@ -0,0 +1,80 @@
+#include "LCD4Pico/LCD4Pico.hpp"
+#include "LCD4Pico/Host/HD44780.hpp"
+#include "LCD4Pico/Symbols.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+static const uint8_t dpins[] = {4, 5, 6, 7};
+
+static uint64_t glyphKey(uint8_t n)
+{
+    const uint8_t glyph[8] = {n, 0, 0, 0, 0, 0, 0, 1};
+    return GlyphCache::key(glyph);
+}
+
+int main()
+{
+    // a glyph uploaded with a decrementing entry mode still lands top down, the entry mode is restored
+    {
+        host::hal().reset();
+        host::HD44780 display(16, 18, 17, dpins);
+        LCD4Pico<_4BIT> lcd(16, 18, 17, dpins);
+        lcd.setup();
+        lcd.setEntryMode(false, false);
+        lcd.moveCursorTo(5);
+        lcd.createCustomCharacter(2, symbols::bell);
+        for (uint8_t row = 0; row < 8; row++)
+            CHECK_EQUAL(display.cgram(2 * 8 + row), symbols::bell[row]);
+        CHECK(!display.isInCGRAM());
+        CHECK_EQUAL(display.addressCounter(), 5);
+
+        lcd.write("ab"); // written to the left
+        CHECK_EQUAL(display.ddram(5), 'a');
+        CHECK_EQUAL(display.ddram(4), 'b');
+        CHECK(display.violations.empty());
+    }
+
+    // the pin of a slot goes with its pattern when the pattern is assigned to another slot
+    {
+        GlyphCache cache;
+        cache.assign(0, glyphKey(1));
+        cache.pin(0, true);
+        cache.assign(1, glyphKey(1)); // slot 0 is free again
+        CHECK_EQUAL(cache.find(glyphKey(1)), 1);
+
+        CHECK_EQUAL(cache.allocate(glyphKey(2), 0), 0);
+        for (uint8_t n = 3; n < 9; n++)
+            CHECK_EQUAL(cache.allocate(glyphKey(n), 0), n - 1);
+        CHECK_EQUAL(cache.find(glyphKey(1)), 1);
+
+        // slot 0 is the least recently used one and replaceable
+        CHECK_EQUAL(cache.allocate(glyphKey(9), 0), 0);
+    }
+
+    // 1 line mode: a glyph shown at 0x02 stays when 0x2A is written, it isn't replaced while it's on the display
+    {
+        host::hal().reset();
+        host::HD44780 display(16, 18, 17, dpins);
+        LCD4Pico<_4BIT, BitBangTransport<_4BIT>, Geometry16x1> lcd(16, 18, 17, dpins);
+        lcd.setup(1);
+        lcd.moveCursorTo(0x02);
+        CHECK(lcd.writeGlyph(symbols::bell));
+        uint8_t code = display.ddram(0x02);
+        lcd.moveCursorTo(0x2A);
+        lcd.write("x");
+
+        // 8 more glyphs than the 7 free slots: the least recently used one that isn't shown is replaced
+        for (uint8_t n = 1; n <= 8; n++)
+        {
+            const uint8_t glyph[8] = {n, 0, 0, 0, 0, 0, 0, 1};
+            uint8_t loaded;
+            CHECK(lcd.loadGlyph(glyph, loaded));
+            CHECK(loaded != code);
+        }
+        for (uint8_t row = 0; row < 8; row++)
+            CHECK_EQUAL(display.cgram(code * 8 + row), symbols::bell[row]);
+        CHECK(display.violations.empty());
+    }
+    return test::checkResult();
+}
@@ -0,0 +1,41 @@
+#include "LCD4Pico/LCD4Pico.hpp"
+#include "LCD4Pico/Host/Benchmark.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+int main()
+{
+    const uint8_t dataPins4[] = {4, 5, 6, 7};
+    const uint8_t dataPins8[] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+    // per nibble: one write per data pin, E high, E low
+    host::hal().reset();
+    host::PerPinTransport<_4BIT> perPin4(16, 18, dataPins4);
+    CHECK_EQUAL(host::measureGpioWrites(perPin4, "per_pin", "4bit").gpioWritesPerByte, 12.0);
+
+    // per nibble: the data pins together with E high, E low
+    host::hal().reset();
+    BitBangTransport<_4BIT> bitBang4(16, 18, dataPins4);
+    CHECK_EQUAL(host::measureGpioWrites(bitBang4, "bit_bang", "4bit").gpioWritesPerByte, 4.0);
+
+    host::hal().reset();
+    host::PerPinTransport<_8BIT> perPin8(16, 18, dataPins8);
+    CHECK_EQUAL(host::measureGpioWrites(perPin8, "per_pin", "8bit").gpioWritesPerByte, 10.0);
+
+    host::hal().reset();
+    BitBangTransport<_8BIT> bitBang8(16, 18, dataPins8);
+    CHECK_EQUAL(host::measureGpioWrites(bitBang8, "bit_bang", "8bit").gpioWritesPerByte, 2.0);
+
+    // the masked writes put the same bytes on the bus
+    host::hal().reset();
+    host::HD44780 display(16, 18, NOT_CONNECTED, dataPins4);
+    LCD4Pico<_4BIT> lcd(16, 18, dataPins4);
+    lcd.setup();
+    lcd.writeLines("0123456789ABCDEF", "ghijklmnopqrstuv");
+    CHECK(display.render(16, 2) == "0123456789ABCDEF\nghijklmnopqrstuv");
+    CHECK(display.violations.empty());
+
+    host::runGpioBenchmarks(stdout);
+    return test::checkResult();
+}
@@ -0,0 +1,84 @@
+#include "LCD4Pico/Host/HD44780.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+// 8bit wiring, the model powers on in 8bit mode
+static const uint8_t dpins[] = {0, 1, 2, 3, 4, 5, 6, 7};
+static constexpr uint8_t E = 16, RW = 17, RS = 18;
+static constexpr uint32_t CONTROL = 1u << E | 1u << RW | 1u << RS;
+
+// puts RS and the data on the bus, waits `setup_ns` and pulses E for `pulse_ns`
+static void strobe(bool rs, uint8_t data, uint32_t setup_ns, uint32_t pulse_ns)
+{
+    host::hal().put(CONTROL | 0xFF, (rs ? 1u << RS : 0) | data);
+    host::hal().sleep_ns(setup_ns);
+    host::hal().put(1u << E, 1u << E);
+    host::hal().sleep_ns(pulse_ns);
+    host::hal().put(1u << E, 0);
+    host::hal().sleep_ns(1000);
+}
+
+static bool raised(const host::HD44780 &display, host::Violation::Kind kind)
+{
+    for (const host::Violation &violation : display.violations)
+    {
+        if (violation.kind == kind)
+            return true;
+    }
+    return false;
+}
+
+int main()
+{
+    host::hal().reset();
+    host::hal().setDirections(CONTROL | 0xFF, CONTROL | 0xFF);
+    host::HD44780 display(E, RS, RW, dpins);
+
+    // a strobe within the datasheet limits
+    strobe(false, 0x38, 100, 500); // function set: 8bit, 2 lines
+    CHECK(display.violations.empty());
+    CHECK_EQUAL(display.instructions, 1);
+    CHECK(display.isTwoLineMode());
+
+    // E high for less than PW_EH (450 ns)
+    host::hal().sleep_ns(40000);
+    strobe(false, 0x0C, 100, 200);
+    CHECK(raised(display, host::Violation::ShortEnablePulse));
+
+    // RS changes together with the rising edge of E, less than t_AS (40 ns) before it
+    display.violations.clear();
+    host::hal().sleep_ns(40000);
+    host::hal().put(CONTROL | 0xFF, 1u << RS | 1u << E | 'a');
+    host::hal().sleep_ns(500);
+    host::hal().put(1u << E, 0);
+    CHECK(raised(display, host::Violation::ShortAddressSetup));
+
+    // the next rising edge of E less than t_cycE (1000 ns) after the last one
+    display.violations.clear();
+    host::hal().sleep_ns(40000);
+    host::hal().put(1u << E, 1u << E);
+    host::hal().sleep_ns(450);
+    host::hal().put(1u << E, 0);
+    host::hal().sleep_ns(100);
+    host::hal().put(1u << E, 1u << E);
+    host::hal().sleep_ns(450);
+    host::hal().put(1u << E, 0);
+    CHECK(raised(display, host::Violation::ShortEnableCycle));
+
+    // a write during the 1.52 ms of a clear display
+    display.violations.clear();
+    host::hal().sleep_ns(40000);
+    strobe(false, 0x01, 100, 500);
+    CHECK(display.isBusy());
+    strobe(true, 'b', 100, 500);
+    CHECK(raised(display, host::Violation::WriteWhileBusy));
+
+    // the same write after the clear display has finished
+    display.violations.clear();
+    host::hal().sleep_ns(1600000);
+    CHECK(!display.isBusy());
+    strobe(true, 'c', 100, 500);
+    CHECK(display.violations.empty());
+    return test::checkResult();
+}
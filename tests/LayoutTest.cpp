@@ -0,0 +1,135 @@
+#include <string>
+#include <vector>
+#include "LCD4Pico/LCD4Pico.hpp"
+#include "LCD4Pico/Layout/Layout.hpp"
+#include "LCD4Pico/Host/HD44780.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+static const uint8_t dpins[] = {4, 5, 6, 7};
+
+using LCD = LCD4Pico<_4BIT>;
+using Screen = Layout<LCD, 4>;
+
+// the DDRAM addresses the cursor was moved to, in the order of the transfers
+static std::vector<uint8_t> cursorJumps(const host::HD44780 &display)
+{
+    std::vector<uint8_t> jumps;
+    for (const host::Transfer &transfer : display.transfers)
+    {
+        if (!transfer.data && transfer.value & 0x80)
+            jumps.push_back(transfer.value & 0x7F);
+    }
+    return jumps;
+}
+
+static std::string written(const host::HD44780 &display)
+{
+    std::string text;
+    for (const host::Transfer &transfer : display.transfers)
+    {
+        if (transfer.data)
+            text += (char)transfer.value;
+    }
+    return text;
+}
+
+int main()
+{
+    host::hal().reset();
+    host::HD44780 display(16, 18, 17, dpins);
+    LCD lcd(16, 18, 17, dpins);
+    lcd.setup();
+    display.recordTransfers = true;
+
+    // regions added out of DDRAM order are written in DDRAM order, neighbours without a cursor jump
+    {
+        Screen layout(lcd);
+        uint8_t number = layout.addNumber(1, 2, 4);
+        uint8_t unit = layout.addLabel(0, 4, 2);
+        uint8_t name = layout.addLabel(0, 0, 4);
+        uint8_t status = layout.addLabel(0, 10, 3);
+        CHECK_EQUAL(layout.addLabel(0, 14, 1), Screen::NO_REGION); // full
+        layout.setText(name, "Temp");
+        layout.setText(unit, "oC");
+        layout.setText(status, "ok");
+        layout.setNumber(number, 215);
+
+        CHECK_EQUAL(layout.update(), 4);
+        CHECK(written(display) == "TempoCok  215");
+        // "oC" follows "Temp" without a jump
+        CHECK(cursorJumps(display) == std::vector<uint8_t>({0x0A, 0x42}));
+        CHECK(display.render() == "TempoC    ok    \n   215          ");
+
+        // nothing changed, nothing is written; setting the same content doesn't make a region dirty
+        display.transfers.clear();
+        layout.setText(name, "Temp");
+        layout.setNumber(number, 215);
+        CHECK(!layout.isDirty(name));
+        CHECK_EQUAL(layout.update(), 0);
+        CHECK(display.transfers.empty());
+    }
+
+    // a region with a minimum interval is written at most once per interval, with the latest value
+    {
+        lcd.clearDisplay();
+        Screen layout(lcd);
+        uint8_t number = layout.addNumber(0, 0, 4, 0, 250000);
+        layout.setNumber(number, 1);
+        CHECK_EQUAL(layout.update(), 1);
+
+        layout.setNumber(number, 2);
+        sleep_us(100000);
+        CHECK_EQUAL(layout.update(), 0);
+        CHECK(layout.isDirty(number));
+        layout.setNumber(number, 3);
+        sleep_us(150000);
+        CHECK_EQUAL(layout.update(), 1);
+        CHECK(!layout.isDirty(number));
+        CHECK(display.render(16, 1) == "   3            ");
+
+        // invalidate makes it due right away
+        layout.invalidate();
+        CHECK_EQUAL(layout.update(), 1);
+    }
+
+    // update(maxRegions) writes the highest priorities, of equal priority the region that is due the longest
+    {
+        lcd.clearDisplay();
+        Screen layout(lcd);
+        uint8_t low = layout.addLabel(0, 0, 1, 1000, 0);
+        uint8_t high = layout.addLabel(0, 2, 1, 1000, 2);
+        uint8_t early = layout.addLabel(1, 0, 1, 1000, 1);
+        uint8_t late = layout.addLabel(1, 2, 1, 1000, 1);
+
+        CHECK_EQUAL(layout.update(2), 2);
+        CHECK(layout.isDirty(low) && !layout.isDirty(high));
+        CHECK(!layout.isDirty(early) || !layout.isDirty(late));
+        CHECK_EQUAL(layout.update(), 2);
+        sleep_us(2000);
+
+        // `early` is written before `late`, so it is due longer
+        layout.setText(early, "e");
+        CHECK_EQUAL(layout.update(1), 1);
+        sleep_us(500);
+        layout.setText(late, "l");
+        CHECK_EQUAL(layout.update(1), 1);
+        sleep_us(2000);
+        layout.setText(early, "E");
+        layout.setText(late, "L");
+        layout.setText(low, "o");
+        display.transfers.clear();
+        CHECK_EQUAL(layout.update(1), 1);
+        CHECK(written(display) == "E");
+        CHECK(layout.isDirty(late) && layout.isDirty(low));
+
+        // the next update writes the rest in DDRAM order
+        display.transfers.clear();
+        CHECK_EQUAL(layout.update(), 2);
+        CHECK(written(display) == "oL");
+        CHECK(display.render() == "o               \nE L             ");
+        CHECK(display.violations.empty());
+    }
+    return test::checkResult();
+}
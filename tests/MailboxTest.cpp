@@ -0,0 +1,110 @@
+#include <thread>
+#include <atomic>
+#include "LCD4Pico/Mailbox/Mailbox.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+static constexpr uint32_t VALUES = 100000;
+static constexpr uint8_t WORDS = 32;
+
+// every word is derived from the sequence number, a torn copy mixes two of them
+struct Payload
+{
+    uint32_t sequence;
+    uint32_t words[WORDS];
+
+    Payload() = default;
+    Payload(const Payload &other) { *this = other; }
+
+    // gives the other thread the chance to run in the middle of the copy, also on a single core
+    Payload &operator=(const Payload &other)
+    {
+        sequence = other.sequence;
+        for (uint8_t i = 0; i < WORDS; i++)
+        {
+            if (i == WORDS / 2)
+                std::this_thread::yield();
+            words[i] = other.words[i];
+        }
+        return *this;
+    }
+};
+
+static Payload payload(uint32_t sequence)
+{
+    Payload value;
+    value.sequence = sequence;
+    for (uint8_t i = 0; i < WORDS; i++)
+        value.words[i] = sequence * 2654435761u + i;
+    return value;
+}
+
+static bool consistent(const Payload &value)
+{
+    for (uint8_t i = 0; i < WORDS; i++)
+    {
+        if (value.words[i] != value.sequence * 2654435761u + i)
+            return false;
+    }
+    return true;
+}
+
+int main()
+{
+    Mailbox<Payload> mailbox;
+    CHECK(!mailbox.acquire());
+
+    std::atomic<bool> done{false};
+    std::thread producer([&]
+                         {
+                             for (uint32_t sequence = 1; sequence <= VALUES; sequence++)
+                                 mailbox.publish(payload(sequence));
+                             done = true; });
+
+    // the consumer runs on this thread, the checks are counted here and reported after the join
+    uint32_t acquired = 0;
+    uint32_t last = 0;
+    uint32_t torn = 0;
+    uint32_t changed = 0;
+    uint32_t outOfOrder = 0;
+    while (!done || mailbox.pending())
+    {
+        const Payload *value = mailbox.acquire();
+        if (!value)
+            continue;
+        acquired++;
+        if (!consistent(*value))
+            torn++;
+        if (value->sequence <= last)
+            outOfOrder++;
+        last = value->sequence;
+
+        // the slot belongs to the consumer until the next acquire, the producer keeps publishing meanwhile
+        uint32_t sequence = value->sequence;
+        std::this_thread::yield();
+        if (value->sequence != sequence || !consistent(*value))
+            changed++;
+    }
+    producer.join();
+
+    CHECK_EQUAL(torn, 0);
+    CHECK_EQUAL(changed, 0);
+    CHECK_EQUAL(outOfOrder, 0);
+    CHECK(acquired > 1);
+    CHECK(acquired <= VALUES);
+
+    // latest wins: the last value acquired is the last one published, nothing is left
+    CHECK_EQUAL(last, VALUES);
+    CHECK_EQUAL(mailbox.published(), VALUES);
+    CHECK(!mailbox.pending());
+    CHECK(!mailbox.acquire());
+
+    // values published while the consumer is busy replace each other
+    mailbox.publish(payload(VALUES + 1));
+    mailbox.publish(payload(VALUES + 2));
+    const Payload *value = mailbox.acquire();
+    CHECK(value && value->sequence == VALUES + 2 && consistent(*value));
+    CHECK(!mailbox.acquire());
+    return test::checkResult();
+}
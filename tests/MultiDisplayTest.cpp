@@ -0,0 +1,72 @@
+#include "LCD4Pico/MultiDisplay/MultiDisplay.hpp"
+#include "LCD4Pico/Host/HD44780.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+using Panel = LCD4Pico<_4BIT, PanelTransport<_4BIT, 2>>;
+
+static const uint8_t dpins[] = {4, 5, 6, 7};
+static const uint8_t enablePins[] = {16, 19};
+
+int main()
+{
+    host::hal().reset();
+    host::HD44780 left(16, 18, 17, dpins);
+    host::HD44780 right(19, 18, 17, dpins);
+
+    // a broadcast reaches both displays, the writes of one display only that display
+    {
+        SharedBus<_4BIT, 2> bus(18, 17, dpins, enablePins);
+        Panel panels[] = {Panel(PanelTransport<_4BIT, 2>(bus, 0)), Panel(PanelTransport<_4BIT, 2>(bus, 1))};
+        MultiDisplay<_4BIT, 2> rack(bus, panels);
+
+        rack.broadcast([](auto &lcd) { lcd.setup(); });
+        CHECK(left.isTwoLineMode());
+        CHECK(right.isTwoLineMode());
+
+        rack.broadcast([](auto &lcd) { lcd.write("hi"); });
+        CHECK_EQUAL(left.ddram(0), 'h');
+        CHECK_EQUAL(right.ddram(1), 'i');
+
+        rack[0].write("A");
+        rack[1].write("BC");
+        CHECK_EQUAL(left.ddram(2), 'A');
+        CHECK_EQUAL(left.ddram(3), ' ');
+        CHECK_EQUAL(right.ddram(2), 'B');
+        CHECK_EQUAL(right.addressCounter(), 4);
+        CHECK_EQUAL(left.addressCounter(), 3);
+    }
+
+    // warm restart of the Pico with the displays' cursors at different cells: a broadcast setup can't tell the displays
+    // apart, so both take the reset sequence and agree with the model of their display
+    {
+        sleep_ms(10); // the Pico reboots
+        SharedBus<_4BIT, 2> bus(18, 17, dpins, enablePins);
+        Panel panels[] = {Panel(PanelTransport<_4BIT, 2>(bus, 0)), Panel(PanelTransport<_4BIT, 2>(bus, 1))};
+        MultiDisplay<_4BIT, 2> rack(bus, panels);
+
+        rack.broadcast([](auto &lcd) { lcd.setup(); });
+        CHECK_EQUAL(left.addressCounter(), 0);
+        CHECK_EQUAL(right.addressCounter(), 0);
+
+        rack[1].moveCursorTo(0);
+        rack[1].write("y");
+        rack[0].moveCursorTo(0);
+        rack[0].write("x");
+        CHECK_EQUAL(left.ddram(0), 'x');
+        CHECK_EQUAL(right.ddram(0), 'y');
+        CHECK_EQUAL(left.ddram(2), 'A'); // the content is kept
+        CHECK_EQUAL(right.ddram(3), 'C');
+
+        // per display the warm start is detected
+        CHECK(rack[0].setup());
+        CHECK(rack[1].setup());
+        rack[1].write("z");
+        CHECK_EQUAL(right.ddram(1), 'z');
+    }
+
+    CHECK(left.violations.empty());
+    CHECK(right.violations.empty());
+    return test::checkResult();
+}
@@ -0,0 +1,62 @@
+#include <string>
+#include "LCD4Pico/LCD4Pico.hpp"
+#include "LCD4Pico/Host/HD44780.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+static const uint8_t dpins[] = {4, 5, 6, 7};
+
+static host::HD44780 *display;
+static LCD4Pico<_4BIT> *lcd;
+
+// writes one field at the head of the first line and returns what the display shows there
+template <class Write>
+static std::string field(Write write, uint8_t length)
+{
+    lcd->clearDisplay();
+    write();
+    return display->render(16, 1).substr(0, length);
+}
+
+int main()
+{
+    host::HD44780 model(16, 18, 17, dpins);
+    LCD4Pico<_4BIT> screen(16, 18, 17, dpins);
+    display = &model;
+    lcd = &screen;
+    lcd->setup();
+
+    CHECK(field([] { lcd->writeNumber(42, 5); }, 6) == "   42 ");
+    CHECK(field([] { lcd->writeNumber(-42, 5); }, 6) == "  -42 ");
+    CHECK(field([] { lcd->writeNumber(-42, 6, '0'); }, 7) == "-00042 ");
+    CHECK(field([] { lcd->writeNumber(-42); }, 4) == "-42 ");
+    CHECK(field([] { lcd->writeNumber(INT32_MIN); }, 12) == "-2147483648 ");
+    CHECK(field([] { lcd->writeNumber(INT32_MIN, 11); }, 12) == "-2147483648 ");
+    CHECK(field([] { lcd->writeNumber(123456, 4); }, 5) == "#### ");
+    CHECK(field([] { lcd->writeNumber(-100, 3); }, 4) == "### ");
+
+    CHECK(field([] { lcd->writeFixed(215, 1, 5); }, 6) == " 21.5 ");
+    CHECK(field([] { lcd->writeFixed(-215, 1); }, 6) == "-21.5 ");
+    CHECK(field([] { lcd->writeFixed(-5, 2); }, 6) == "-0.05 ");
+    CHECK(field([] { lcd->writeFixed(7, 0); }, 2) == "7 ");
+    CHECK(field([] { lcd->writeFixed(INT32_MIN, 9); }, 14) == "-2.147483648  ");
+    CHECK(field([] { lcd->writeFixed(12345, 2, 5); }, 6) == "##### ");
+    CHECK(field([] { lcd->writeFixed(1, 10, 4); }, 4) == "    "); // more than 9 decimals writes nothing
+
+    CHECK(field([] { lcd->writeHex(0xBE, 4); }, 5) == "00BE ");
+    CHECK(field([] { lcd->writeHex(0xDEADBEEF); }, 9) == "DEADBEEF ");
+    CHECK(field([] { lcd->writeHex(0x12345, 4); }, 5) == "#### ");
+
+    // a padded field is one write: its cells and no instruction
+    lcd->clearDisplay();
+    uint64_t instructions = display->instructions;
+    uint64_t dataWrites = display->dataWrites;
+    lcd->writeNumber(7, 8, '0');
+    CHECK_EQUAL(display->instructions - instructions, 0);
+    CHECK_EQUAL(display->dataWrites - dataWrites, 8);
+    CHECK(display->render(16, 1) == "00000007        ");
+
+    CHECK(display->violations.empty());
+    return test::checkResult();
+}
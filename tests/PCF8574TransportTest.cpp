@@ -0,0 +1,70 @@
+#include "LCD4Pico/LCD4Pico.hpp"
+#include "LCD4Pico/Transport/PCF8574Transport.hpp"
+#include "LCD4Pico/Host/HD44780.hpp"
+#include "LCD4Pico/Host/PCF8574.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+using Transport = PCF8574Transport<>;
+
+static_assert(!supportsBitMode<Transport>(_8BIT, 0), "the backpack only works in 4bit mode");
+
+// backpack wiring: P0 = RS, P1 = RW, P2 = E, P3 = backlight, P4-P7 = D4-D7, the outputs drive these simulated GPIOs
+static const uint8_t expanderPins[] = {10, 11, 12, 13, 14, 15, 16, 17};
+static const uint8_t dpins[] = {14, 15, 16, 17};
+
+int main()
+{
+    host::hal().reset();
+    host::PCF8574 expander(0x27, expanderPins);
+    host::HD44780 display(12, 10, 11, dpins);
+    display.recordTransfers = true;
+
+    LCD4Pico<_4BIT, Transport> lcd(Transport(i2c0, 4, 5, 0x27));
+    lcd.setup();
+    CHECK(lcd.transport().isConnected());
+
+    // the expander writes decode into the 4bit reset sequence (the first nibbles are read in 8bit mode)
+    const uint8_t initialization[] = {0x30, 0x30, 0x30, 0x20};
+    CHECK(display.transfers.size() > count_of(initialization));
+    for (uint8_t i = 0; i < count_of(initialization) && i < display.transfers.size(); i++)
+    {
+        CHECK(!display.transfers[i].data);
+        CHECK_EQUAL(display.transfers[i].value, initialization[i]);
+    }
+
+    // a whole string is one I2C transaction, every character arrives as one data transfer
+    display.transfers.clear();
+    uint32_t transactions = lcd.transport().transactions();
+    lcd.write("Hello,");
+    CHECK_EQUAL(lcd.transport().transactions(), transactions + 1);
+    CHECK_EQUAL(display.transfers.size(), 6);
+    for (uint8_t i = 0; i < 6 && i < display.transfers.size(); i++)
+    {
+        CHECK(display.transfers[i].data);
+        CHECK_EQUAL(display.transfers[i].value, "Hello,"[i]);
+    }
+
+    // the waiting times are kept by the padding writes, also after a clear display
+    lcd.clearDisplay();
+    lcd.writeLines("Hello,", "World!");
+    CHECK(display.render() == "Hello,          \nWorld!          ");
+    CHECK(display.violations.empty());
+
+    // init drives the backlight bit high, switching it off doesn't strobe E
+    CHECK(expander.outputs() & Transport::BACKLIGHT_BIT);
+    size_t transfers = display.transfers.size();
+    lcd.transport().setBacklight(false);
+    CHECK(!(expander.outputs() & Transport::BACKLIGHT_BIT));
+    CHECK(!lcd.transport().backlight());
+    lcd.write("!");
+    CHECK(!(expander.outputs() & Transport::BACKLIGHT_BIT));
+    CHECK_EQUAL(display.transfers.size(), transfers + 1);
+
+    // no device at the address: nothing is acknowledged
+    Transport missing(i2c0, 4, 5, 0x3F);
+    missing.init();
+    CHECK(!missing.isConnected());
+    return test::checkResult();
+}
@@ -0,0 +1,49 @@
+// built with LCD4PICO_PERF_COUNTERS and LCD4PICO_TRACE (see CMakeLists.txt)
+#include "LCD4Pico/LCD4Pico.hpp"
+#include "LCD4Pico/Host/HD44780.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+static const uint8_t dpins[] = {4, 5, 6, 7};
+
+int main()
+{
+    host::hal().reset();
+    host::HD44780 display(16, 18, 17, dpins);
+    LCD4Pico<_4BIT> lcd(16, 18, 17, dpins);
+    TraceBuffer<256> trace;
+    lcd.setTrace(&trace);
+    lcd.setup();
+    lcd.waitUntilReady();
+    lcd.resetPerfCounters();
+    trace.clear();
+
+    // the write waits for the clear, that wait is charged to the clear
+    lcd.clearDisplay();
+    lcd.write("ab");
+    lcd.returnHome();
+    lcd.write("c");
+
+    PerfCounters counters = lcd.perfCounters();
+    CHECK_EQUAL(counters.instructions, 2);
+    CHECK_EQUAL(counters.dataBytes, 3);
+    CHECK(counters.busyFlagReads > 0);
+    CHECK_EQUAL(counters.strobes, 2 * (counters.instructions + counters.dataBytes + counters.busyFlagReads));
+    CHECK_EQUAL(trace.recorded(), counters.instructions + counters.dataBytes + counters.busyFlagReads);
+
+    CHECK_EQUAL(counters.clearDisplay.calls, 1);
+    CHECK(counters.clearDisplay.max_us >= display.timing.clearOrHome_ns / 1000);
+    CHECK_EQUAL(counters.clearDisplay.buckets[4], 1); // 1-4 ms
+    CHECK_EQUAL(counters.returnHome.calls, 1);
+    CHECK(counters.returnHome.max_us >= display.timing.clearOrHome_ns / 1000);
+
+    CHECK_EQUAL(counters.write.calls, 2);
+    CHECK(counters.write.max_us < 256);
+    CHECK_EQUAL(counters.write.buckets[4], 0);
+    CHECK(counters.deferredWait_us >= 2 * 1400);
+    CHECK(counters.deferredWait_us <= counters.waitWhileBusy_us);
+
+    CHECK(display.violations.empty());
+    return test::checkResult();
+}
@@ -0,0 +1,88 @@
+#include "LCD4Pico/LCD4Pico.hpp"
+#include "LCD4Pico/Transport/PioTransport.hpp"
+#include "LCD4Pico/Host/HD44780.hpp"
+#include "LCD4Pico/Symbols.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+static const uint8_t dpins[] = {4, 5, 6, 7};
+
+// more than the 256 words of the ring, so the DMA wraps around it
+template <class LCD>
+static void workload(LCD &lcd)
+{
+    lcd.setup();
+    lcd.writeLines("Hello,", "World!");
+    lcd.createCustomCharacter(0, symbols::bell);
+    lcd.clearDisplay();
+    for (uint8_t round = 0; round < 4; round++)
+    {
+        lcd.moveCursorTo(0);
+        lcd.write("0123456789ABCDEF0123456789ABCDEFabcdefgh");
+        lcd.moveCursorTo(0x40);
+        lcd.write("abcdefghijklmnopqrstuvwxyz0123456789ABCD");
+    }
+    lcd.shiftDisplay(Direction::Left);
+    lcd.returnHome();
+    lcd.writeCustomCharacter(0);
+}
+
+int main()
+{
+    std::vector<host::Transfer> bitBang;
+    std::string bitBangScreen;
+    {
+        host::hal().reset();
+        host::HD44780 display(16, 18, NOT_CONNECTED, dpins);
+        display.recordTransfers = true;
+        LCD4Pico<_4BIT> lcd(16, 18, dpins);
+        workload(lcd);
+        bitBang = display.transfers;
+        bitBangScreen = display.render(16, 2);
+        CHECK(display.violations.empty());
+    }
+
+    using Transport = PioTransport<_4BIT>;
+    host::hal().reset();
+    host::HD44780 display(16, 18, NOT_CONNECTED, dpins);
+    display.recordTransfers = true;
+    LCD4Pico<_4BIT, Transport> lcd(Transport(pio0, 16, 18, 4));
+    workload(lcd);
+    lcd.transport().sync();
+
+    // the state machine puts the same bytes on the bus as the CPU
+    CHECK(bitBang.size() > 256);
+    CHECK_EQUAL(display.transfers.size(), bitBang.size());
+    for (size_t i = 0; i < bitBang.size() && i < display.transfers.size(); i++)
+    {
+        CHECK_EQUAL(display.transfers[i].data, bitBang[i].data);
+        CHECK_EQUAL(display.transfers[i].value, bitBang[i].value);
+    }
+    CHECK(display.render(16, 2) == bitBangScreen);
+    CHECK(display.violations.empty());
+    CHECK_EQUAL(host::pio(0).unsupportedInstructions, 0);
+
+    // a delay longer than the state machine can wait is waited once on the CPU
+    Transport &bus = lcd.transport();
+    bus.delay(Transport::MAX_DELAY_US + 5000);
+    uint64_t start_ns = display.transfers.back().time_ns;
+    lcd.write("!");
+    bus.sync();
+    uint64_t gap_us = (display.transfers.back().time_ns - start_ns) / 1000;
+    CHECK(gap_us >= Transport::MAX_DELAY_US + 5000);
+    CHECK(gap_us < Transport::MAX_DELAY_US + 5000 + 100);
+    CHECK(display.violations.empty());
+
+    // a copy claims its own state machine and DMA channel, the original keeps working
+    {
+        Transport copy(bus);
+        copy.init();
+        copy.setRegister(DATA_REGISTER);
+    }
+    lcd.write("?");
+    bus.sync();
+    CHECK_EQUAL(display.transfers.back().value, '?');
+
+    return test::checkResult();
+}
@@ -0,0 +1,116 @@
+#include "LCD4Pico/LCD4Pico.hpp"
+#include <string>
+#include "LCD4Pico/Transport/QueuedTransport.hpp"
+#include "LCD4Pico/Host/HD44780.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+static const uint8_t dpins[] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+using Transport = QueuedTransport<_8BIT, 2>; // 4 transfers
+
+// the controller is in its power on state (8bit, 1 line), so data bytes go straight into the DDRAM
+static void writeCharacters(Transport &transport, const char *text, uint32_t delay_us = 50)
+{
+    transport.setRegister(DATA_REGISTER);
+    for (; *text; text++)
+    {
+        transport.delay(delay_us);
+        transport.write(*text);
+    }
+}
+
+static std::string written(const host::HD44780 &display)
+{
+    std::string text;
+    for (const host::Transfer &transfer : display.transfers)
+        text += (char)transfer.value;
+    return text;
+}
+
+int main()
+{
+    // Drop: the writes that don't fit into the full queue are counted and discarded, nothing blocks
+    {
+        host::hal().reset();
+        host::HD44780 display(16, 18, NOT_CONNECTED, dpins);
+        display.recordTransfers = true;
+        Transport transport(16, 18, dpins, QueueFullPolicy::Drop);
+        transport.init();
+        uint64_t start_ns = host::hal().now_ns;
+        writeCharacters(transport, "abcdefghij");
+        CHECK(host::hal().now_ns - start_ns < 50000); // less than one transfer delay passed
+        CHECK_EQUAL(transport.dropped(), 6);
+        transport.sync();
+        CHECK(written(display) == "abcd");
+        CHECK(display.violations.empty());
+    }
+
+    // Block: a write waits for a free slot, every transfer arrives in order
+    {
+        host::hal().reset();
+        host::HD44780 display(16, 18, NOT_CONNECTED, dpins);
+        display.recordTransfers = true;
+        Transport transport(16, 18, dpins);
+        transport.init();
+        writeCharacters(transport, "abcdefghij");
+        transport.sync();
+        CHECK_EQUAL(transport.dropped(), 0);
+        CHECK(written(display) == "abcdefghij");
+        CHECK(display.violations.empty());
+    }
+
+    // no free alarm slot: the waiting writes and sync send the queue themselves instead of spinning forever
+    {
+        host::hal().reset();
+        host::hal().alarmSlots = 0;
+        host::HD44780 display(16, 18, NOT_CONNECTED, dpins);
+        display.recordTransfers = true;
+        Transport transport(16, 18, dpins);
+        transport.init();
+        writeCharacters(transport, "abcdefghij");
+        transport.sync();
+        CHECK(written(display) == "abcdefghij");
+        CHECK(display.violations.empty());
+        host::hal().alarmSlots = 16;
+    }
+
+    // every transfer is sent in order and no earlier than its delay after the previous one
+    {
+        host::hal().reset();
+        host::HD44780 display(16, 18, NOT_CONNECTED, dpins);
+        display.recordTransfers = true;
+        Transport transport(16, 18, dpins);
+        transport.init();
+
+        const uint32_t delays_us[] = {50, 45, 1600, 300, 40, 2000, 45}; // before each transfer, clear and return home take 1.52 ms
+        const uint8_t values[] = {'x', 0x01, 'y', 'z', 0x02, 'w', 'v'};
+        for (uint8_t i = 0; i < count_of(values); i++)
+        {
+            transport.delay(delays_us[i]);
+            transport.setRegister(values[i] > 0x02);
+            transport.write(values[i]);
+        }
+        transport.sync();
+
+        CHECK_EQUAL(display.transfers.size(), count_of(values));
+        for (uint8_t i = 0; i < count_of(values) && i < display.transfers.size(); i++)
+        {
+            CHECK_EQUAL(display.transfers[i].value, values[i]);
+            if (i)
+                CHECK(display.transfers[i].time_ns - display.transfers[i - 1].time_ns >= delays_us[i] * 1000ull);
+        }
+        CHECK(display.violations.empty());
+
+        // a delay longer than a transfer can carry is waited once on the CPU
+        transport.delay(Transport::MAX_DELAY_US + 5000);
+        transport.setRegister(DATA_REGISTER);
+        transport.write('!');
+        transport.sync();
+        uint64_t gap_us = (display.transfers.back().time_ns - display.transfers[display.transfers.size() - 2].time_ns) / 1000;
+        CHECK(gap_us >= Transport::MAX_DELAY_US + 5000);
+        CHECK(gap_us < Transport::MAX_DELAY_US + 5000 + 100);
+    }
+    return test::checkResult();
+}
@@ -0,0 +1,35 @@
+#include "LCD4Pico/LCD4Pico.hpp"
+#include "LCD4Pico/Host/HD44780.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+static const uint8_t dpins[] = {4, 5, 6, 7};
+
+constexpr auto splash = Sequence<16>().clear().moveTo(0x04).text("LCD4Pico").moveTo(0x40).text("v1");
+static_assert(!splash.overflowed && splash.length == 13, "a sequence within its capacity keeps every operation");
+
+constexpr auto tooLong = Sequence<4>().clear().text("abcdef");
+static_assert(tooLong.overflowed && tooLong.length == 4, "the operations beyond the capacity are dropped");
+
+int main()
+{
+    // the same at runtime, the operations after the capacity are not written anywhere
+    Sequence<3> sequence;
+    sequence.text("x");
+    CHECK(!sequence.overflowed);
+    sequence.text("yzw").moveTo(0x40);
+    CHECK(sequence.overflowed);
+    CHECK_EQUAL(sequence.length, 3);
+    CHECK_EQUAL(sequence.operations[2], Sequence<3>::DATA | 'z');
+
+    host::HD44780 display(16, 18, 17, dpins);
+    LCD4Pico<_4BIT> lcd(16, 18, 17, dpins);
+    lcd.setup();
+    lcd.play(splash);
+    CHECK(display.render(16, 2) == "    LCD4Pico    \nv1              ");
+    lcd.play(tooLong);
+    CHECK(display.render(16, 2) == "abc             \n                ");
+    CHECK(display.violations.empty());
+    return test::checkResult();
+}
@@ -0,0 +1,61 @@
+#include "LCD4Pico/LCD4Pico.hpp"
+#include "LCD4Pico/Host/HD44780.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+static const uint8_t dpins[] = {4, 5, 6, 7};
+
+int main()
+{
+    host::hal().reset();
+    host::HD44780 display(16, 18, 17, dpins);
+    display.recordTransfers = true;
+
+    // cold start: nothing reaches the display before the power on time, then the reset sequence
+    {
+        LCD4Pico<_4BIT> lcd(16, 18, 17, dpins);
+        CHECK(!lcd.setup());
+        CHECK(!display.transfers.empty());
+        CHECK(display.transfers.front().time_ns >= POWER_ON_TIME * 1000ull);
+        CHECK(display.isTwoLineMode());
+        CHECK_EQUAL(display.addressCounter(), 0);
+
+        lcd.write("Hi");
+        lcd.moveCursorTo(5);
+    }
+
+    // warm start (only the Pico was reset): the content and the cursor are kept
+    {
+        sleep_ms(10);
+        LCD4Pico<_4BIT> lcd(16, 18, 17, dpins);
+        CHECK(lcd.setup());
+        CHECK_EQUAL(display.ddram(0), 'H');
+        CHECK_EQUAL(display.ddram(1), 'i');
+        CHECK_EQUAL(display.addressCounter(), 5);
+        lcd.write("x");
+        CHECK_EQUAL(display.ddram(5), 'x');
+    }
+
+    // the Pico was reset in the middle of a byte: the display waits for the lower nibble, the probe fails and
+    // the reset sequence brings the interface back in step
+    {
+        BitBangTransport<_4BIT> pins(16, 18, 17, dpins);
+        pins.init();
+        pins.setRegister(INSTRUCTION_REGISTER);
+        pins.writeUpperNibble(0x80);
+        sleep_ms(10);
+
+        LCD4Pico<_4BIT> lcd(16, 18, 17, dpins);
+        CHECK(!lcd.setup());
+        CHECK(display.isTwoLineMode());
+        CHECK_EQUAL(display.addressCounter(), 0);
+        lcd.write("ok");
+        CHECK_EQUAL(display.ddram(0), 'o');
+        CHECK_EQUAL(display.ddram(1), 'k');
+        CHECK_EQUAL(display.ddram(5), 'x'); // the content is kept
+    }
+
+    CHECK(display.violations.empty());
+    return test::checkResult();
+}
@@ -0,0 +1,83 @@
+#include <memory>
+#include "LCD4Pico/LCD4Pico.hpp"
+#include "LCD4Pico/Host/HD44780.hpp"
+#include "LCD4Pico/Symbols.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+static const uint8_t dpins[] = {4, 5, 6, 7};
+
+static bool showsGlyph(const host::HD44780 &display, uint8_t slot, const uint8_t (&glyph)[8])
+{
+    for (uint8_t row = 0; row < 8; row++)
+    {
+        if ((display.cgram(slot * 8 + row) & 0x1F) != glyph[row])
+            return false;
+    }
+    return true;
+}
+
+int main()
+{
+    host::hal().reset();
+    auto display = std::make_unique<host::HD44780>(16, 18, 17, dpins);
+    LCD4Pico<_4BIT> lcd(16, 18, 17, dpins);
+    lcd.setup();
+    lcd.writeLines("Hello", "World");
+    lcd.createCustomCharacter(3, symbols::bell);
+    lcd.setEntryMode(false, false);
+    lcd.moveCursorTo(0x45);
+
+    // the snapshot holds both lines and the glyph, the cursor and the decrementing entry mode are put back
+    ScreenSnapshot screen;
+    CHECK(lcd.snapshot(screen));
+    CHECK_EQUAL(screen.ddram[0], 'H');
+    CHECK_EQUAL(screen.ddram[4], 'o');
+    CHECK_EQUAL(screen.ddram[40], 'W');
+    CHECK_EQUAL(screen.ddram[44], 'd');
+    for (uint8_t row = 0; row < 8; row++)
+        CHECK_EQUAL(screen.cgram[3 * 8 + row] & 0x1F, symbols::bell[row]);
+    CHECK_EQUAL(display->addressCounter(), 0x45);
+    CHECK(!display->isInCGRAM());
+    CHECK(lcd.verify(screen));
+    CHECK_EQUAL(display->addressCounter(), 0x45);
+
+    lcd.write("x");
+    CHECK_EQUAL(display->ddram(0x45), 'x');
+    CHECK_EQUAL(display->addressCounter(), 0x44);
+    CHECK(!lcd.verify(screen));
+
+    // brown-out: the display lost its memory, the restore brings back both lines and the glyph
+    display = std::make_unique<host::HD44780>(16, 18, 17, dpins);
+    lcd.setup();
+    lcd.setEntryMode(false, true);
+    lcd.moveCursorTo(0x07);
+    CHECK(!lcd.verify(screen));
+    lcd.restore(screen);
+    CHECK(lcd.verify(screen));
+    CHECK(display->render(16, 2) == "Hello           \nWorld           ");
+    CHECK(showsGlyph(*display, 3, symbols::bell));
+    CHECK_EQUAL(display->addressCounter(), 0x07);
+    CHECK(!display->isInCGRAM());
+
+    // the glyph cache took over the restored glyph, loading it again sends nothing
+    uint64_t writes = display->dataWrites;
+    uint8_t code = UINT8_MAX;
+    CHECK(lcd.loadGlyph(symbols::bell, code));
+    CHECK_EQUAL(code, 3);
+    CHECK_EQUAL(display->dataWrites, writes);
+
+    CHECK(display->violations.empty());
+
+    // without the RW pin there's nothing to read
+    {
+        host::hal().reset();
+        host::HD44780 writeOnly(16, 18, 17, dpins);
+        LCD4Pico<_4BIT> lcd(16, 18, dpins);
+        lcd.setup();
+        CHECK(!lcd.snapshot(screen));
+        CHECK(!lcd.verify(screen));
+    }
+    return test::checkResult();
+}
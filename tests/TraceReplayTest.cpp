@@ -0,0 +1,96 @@
+// built with LCD4PICO_TRACE (see CMakeLists.txt)
+#include <unistd.h>
+#include "LCD4Pico/LCD4Pico.hpp"
+#include "LCD4Pico/Host/HD44780.hpp"
+#include "LCD4Pico/Host/TraceReplay.hpp"
+#include "LCD4Pico/Symbols.hpp"
+#include "tests/Check.hpp"
+
+using namespace lcd4pico;
+
+static const uint8_t dpins[] = {4, 5, 6, 7};
+
+// parses what `dump` prints to stdout
+static bool dumpAndRead(const Trace &trace, host::RecordedTrace &recorded)
+{
+    FILE *file = tmpfile();
+    fflush(stdout);
+    int out = dup(fileno(stdout));
+    dup2(fileno(file), fileno(stdout));
+    trace.dump();
+    fflush(stdout);
+    dup2(out, fileno(stdout));
+    close(out);
+
+    rewind(file);
+    bool read = host::readTrace(file, recorded);
+    fclose(file);
+    return read;
+}
+
+// writes a screen and returns the whole DDRAM of the display, rendered
+template <uint16_t capacity>
+static std::string record(TraceBuffer<capacity> &trace, host::RecordedTrace &recorded)
+{
+    host::hal().reset();
+    host::HD44780 display(16, 18, 17, dpins);
+    LCD4Pico<_4BIT> lcd(16, 18, 17, dpins);
+    lcd.setTrace(&trace);
+    lcd.setup();
+    lcd.writeLines("Trace", "replay");
+    lcd.createCustomCharacter(1, symbols::bell);
+    lcd.moveCursorTo(0x20);
+    lcd.write("end");
+    lcd.writeCustomCharacter(1);
+    sleep_ms(20); // an idle gap
+    lcd.moveCursorTo(0x60);
+    lcd.write("last");
+
+    CHECK(dumpAndRead(trace, recorded));
+    CHECK(display.violations.empty());
+    return display.render(40, 2);
+}
+
+int main()
+{
+    // the whole trace from power on: the replay ends with the same DDRAM
+    {
+        TraceBuffer<1024> trace;
+        host::RecordedTrace recorded;
+        std::string expected = record(trace, recorded);
+        CHECK(expected.find("Trace") != std::string::npos);
+
+        CHECK_EQUAL(recorded.bitMode, _4BIT);
+        CHECK_EQUAL(recorded.recorded, trace.recorded());
+        CHECK_EQUAL(recorded.events.size(), trace.size());
+        for (uint16_t i = 0; i < trace.size() && i < recorded.events.size(); i++)
+        {
+            CHECK_EQUAL(recorded.events[i].delta_us, trace.at(i).delta_us);
+            CHECK_EQUAL(recorded.events[i].data, trace.at(i).data);
+            CHECK_EQUAL(recorded.events[i].flags, trace.at(i).flags);
+        }
+
+        host::TraceReport report = host::replayTrace(recorded, 40, 2, 10000);
+        CHECK(report.complete);
+        CHECK(report.screen == expected);
+        CHECK_EQUAL(report.violations, 0);
+        CHECK_EQUAL(report.readMismatches, 0);
+        CHECK_EQUAL(report.longGaps, 1); // the idle gap
+        CHECK(report.maxGap_us >= 20000);
+    }
+
+    // the oldest events were overwritten: only the cells written within the trace come back
+    {
+        TraceBuffer<32> trace;
+        host::RecordedTrace recorded;
+        record(trace, recorded);
+
+        CHECK(recorded.recorded > recorded.events.size());
+        host::TraceReport report = host::replayTrace(recorded, 40, 2);
+        CHECK(!report.complete);
+        CHECK_EQUAL(report.violations, 0);
+        CHECK(report.screen.find("last") != std::string::npos);
+        CHECK(report.screen.find("Trace") == std::string::npos);
+    }
+    return test::checkResult();
+}